@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cassert>
+#include <cstdint>
 #include <vector>
+#include <algorithm>
+#include <typeinfo>
 using namespace std;
 
 /*
@@ -12,12 +16,75 @@ using namespace std;
 * Goblin starts with (1, 1) by default, and GoblinKing with (3,3). 
 */
 
+/*
+* In the broker chain, each stat read queries every creature in game, via a virtual call, so reading the stats of all the creatures
+* is O(n^2). However, the goblins' modifiers are constant: a goblin gives +1 defense to every other creature, whatever it is, and
+* a goblin king gives +1 attack and +1 defense. Thus, in the Aggregates mode, the game keeps the sum of the constant modifiers
+* of all its creatures, updated when a creature is added or removed, and a stat is the creature's own value, plus that sum,
+* minus the creature's own modifier, as it does not apply to itself, so reading it is O(1). The creatures whose modifiers
+* are not constant, as they depend on the queried creature, are custom modifiers: the game keeps them apart, and
+* they are still queried through the chain, so each stat read walks only them.
+* The custom modifiers are queried after the creature's own value and the aggregates are added, rather than at their position
+* in the chain, so they must be additive: they may add any bonus, depending on the queried creature, but not depending on the
+* result accumulated so far, e.g. they must not double it. As the additions commute, the result is then the same as in the
+* Chain mode. This is checked by an assertion, in debug builds, which queries each custom modifier with a zero result as well.
+* In the Aggregates mode, the creatures must be added and removed via add_creature and remove_creature, instead of modifying
+* creatures directly, so the aggregates are kept up to date.
+*
+* As the stats are read far more often than the creatures change, a game can also cache them: each creature keeps the result
+* of its last query of each stat, stamped with the game's version, which is incremented whenever a creature is added or removed.
+* A query finding a stamp equal to the current version returns the cached result, without walking the chain. The version must
+* also be incremented, by invalidate_stats, when a modifier changes otherwise, e.g. when the bonus of a custom modifier depends
+* on a state which changes. The cache is enabled in either mode, but it requires the creatures to be added and removed via
+* add_creature and remove_creature, thus it is disabled by default, as modifying creatures directly would leave stale results.
+*/
+
 struct Creature;
 
+//the bonus a creature gives to every other creature in game
+struct StatModifier
+{
+    int attack{0};
+    int defense{0};
+};
+
 //mediator: defines a chain of objects acting as a broker for computing attributes values that depend on the exitsence of other objects
 struct Game
 {
+    enum class QueryMode { Chain, Aggregates };
+
     vector<Creature*> creatures;
+    QueryMode mode{QueryMode::Chain};
+    //the sum of the constant modifiers of all the creatures
+    StatModifier aggregatedModifier{};
+    //the creatures whose modifiers are not constant, which have to be queried
+    vector<Creature*> customModifiers;
+    bool cachesStats{false};
+    //incremented on each change of the modifiers, so the stats cached with an older version are stale
+    uint64_t version{1};
+
+    Game() = default;
+    explicit Game(QueryMode mode, bool cachesStats = false) : mode(mode), cachesStats(cachesStats) {}
+
+    void invalidate_stats()
+    {
+        ++version;
+    }
+
+    void add_creature(Creature* creature);
+    void remove_creature(Creature* creature);
+
+    //the stats of all the creatures, as struct of arrays, in the order of creatures
+    struct CreatureStats
+    {
+        vector<int> attack;
+        vector<int> defense;
+        //the custom modifiers found whilst computing, kept here so their capacity is reused by the next computation
+        vector<Creature*> customModifiers;
+    };
+
+    void compute_all_stats(CreatureStats& stats) const;
+    CreatureStats compute_all_stats() const;
 };
 
 struct StatQuery
@@ -40,8 +107,229 @@ struct Creature
 
         //add a new virtual method that should eb overriden by Goblin and GoblinKing accordingly
         virtual void query(void* source, StatQuery& sq) = 0;
+
+        //returns true, and the modifier, if the creature gives the same bonus to all the others, whatever they are, so it can be aggregated
+        //the classes derived from a class returning true are not aggregated, unless they override this method as well
+        virtual bool get_constant_modifier(StatModifier&) const
+        {
+            return false;
+        }
+
+        virtual ~Creature() = default;
+
+    protected:
+        //returns the cached result, if the game has not changed since it was computed
+        int query_statistic(StatQuery::Statistic statistic)
+        {
+            CachedStatistic& cachedStatistic = cachedStatistics[statistic];
+
+            if(game.cachesStats && cachedStatistic.version == game.version)
+            {
+                return cachedStatistic.value;
+            }
+
+            const int result = compute_statistic(statistic);
+
+            if(game.cachesStats)
+            {
+                cachedStatistic = CachedStatistic{game.version, result};
+            }
+
+            return result;
+        }
+
+    private:
+        //the version 0 is never the game's, so the statistics are not cached initially
+        struct CachedStatistic
+        {
+            uint64_t version{0};
+            int value{0};
+        };
+
+        CachedStatistic cachedStatistics[2]{};
+
+        //walks the whole chain, or, in the Aggregates mode, only the custom modifiers
+        int compute_statistic(StatQuery::Statistic statistic)
+        {
+            StatQuery q{statistic, 0};
+
+            if(game.mode == Game::QueryMode::Chain)
+            {
+                //iterate through the chain of objects and query each one, including self, using same query object
+                //thus, each iterated object is queried for this object using each time the query defined above
+                for(auto&& creature : game.creatures)
+                {
+                    creature->query(this, q);
+                }
+
+                return q.result;
+            }
+
+            //querying self adds the creature's own value
+            query(this, q);
+
+            //the own modifier is part of the aggregates, but does not apply to self
+            StatModifier ownModifier{};
+            get_constant_modifier(ownModifier);
+            q.result += (statistic == StatQuery::attack) ? game.aggregatedModifier.attack - ownModifier.attack
+                                                         : game.aggregatedModifier.defense - ownModifier.defense;
+
+            for(auto&& creature : game.customModifiers)
+            {
+                if(creature != this)
+                {
+                    creature->query_custom_modifier(this, q);
+                }
+            }
+
+            return q.result;
+        }
+
+        //queries a creature whose modifier is not constant, out of its position in the chain
+        void query_custom_modifier(void* source, StatQuery& sq)
+        {
+            const int previousResult = sq.result;
+            query(source, sq);
+
+#ifndef NDEBUG
+            StatQuery bonusQuery{sq.statistic, 0};
+            query(source, bonusQuery);
+            assert(sq.result - previousResult == bonusQuery.result && "custom modifiers must be additive");
+#else
+            (void)previousResult;
+#endif
+        }
+
+        friend struct Game;
 };
 
+inline void Game::add_creature(Creature* creature)
+{
+    creatures.push_back(creature);
+    invalidate_stats();
+
+    StatModifier modifier{};
+    if(creature->get_constant_modifier(modifier))
+    {
+        aggregatedModifier.attack += modifier.attack;
+        aggregatedModifier.defense += modifier.defense;
+    }
+    else
+    {
+        customModifiers.push_back(creature);
+    }
+}
+
+/*
+* Computes the stats of all the creatures at once, in either mode, with the same results as get_attack and get_defense
+* for each of them, provided the custom modifiers are additive (see above), but without walking the chain for each creature:
+*   - a first pass buckets the modifiers: the constant ones are summed, the custom ones are gathered, and the stats are set
+*     to the creatures' own values, minus their own constant modifiers, which do not apply to themselves
+*   - a second pass adds the sum of the constant modifiers to all the stats, a loop over int arrays, which the compiler vectorizes
+*   - the custom modifiers, if any, are then queried for each creature, as through the chain
+* Thus, it takes O(n) virtual calls, plus n for each custom modifier, instead of n^2. The stats are written to the vectors
+* of the given instance, which keep their capacity, so a game loop calling it each frame does not allocate.
+*/
+inline void Game::compute_all_stats(CreatureStats& stats) const
+{
+    const size_t creaturesCount = creatures.size();
+    stats.attack.resize(creaturesCount);
+    stats.defense.resize(creaturesCount);
+
+    StatModifier totalModifier{};
+    vector<Creature*>& customCreatures = stats.customModifiers;
+    customCreatures.clear();
+
+    for(size_t idx{0}; idx < creaturesCount; ++idx)
+    {
+        Creature* creature = creatures[idx];
+        StatQuery attackQuery{StatQuery::attack, 0};
+        StatQuery defenseQuery{StatQuery::defense, 0};
+
+        //querying self adds the creature's own value
+        creature->query(creature, attackQuery);
+        creature->query(creature, defenseQuery);
+
+        StatModifier modifier{};
+        if(creature->get_constant_modifier(modifier))
+        {
+            totalModifier.attack += modifier.attack;
+            totalModifier.defense += modifier.defense;
+        }
+        else
+        {
+            customCreatures.push_back(creature);
+        }
+
+        stats.attack[idx] = attackQuery.result - modifier.attack;
+        stats.defense[idx] = defenseQuery.result - modifier.defense;
+    }
+
+    int* attack = stats.attack.data();
+    int* defense = stats.defense.data();
+    for(size_t idx{0}; idx < creaturesCount; ++idx)
+    {
+        attack[idx] += totalModifier.attack;
+        defense[idx] += totalModifier.defense;
+    }
+
+    for(Creature* customCreature : customCreatures)
+    {
+        for(size_t idx{0}; idx < creaturesCount; ++idx)
+        {
+            if(creatures[idx] != customCreature)
+            {
+                StatQuery attackQuery{StatQuery::attack, attack[idx]};
+                StatQuery defenseQuery{StatQuery::defense, defense[idx]};
+
+                customCreature->query_custom_modifier(creatures[idx], attackQuery);
+                customCreature->query_custom_modifier(creatures[idx], defenseQuery);
+
+                attack[idx] = attackQuery.result;
+                defense[idx] = defenseQuery.result;
+            }
+        }
+    }
+}
+
+inline Game::CreatureStats Game::compute_all_stats() const
+{
+    CreatureStats stats{};
+    compute_all_stats(stats);
+
+    return stats;
+}
+
+inline void Game::remove_creature(Creature* creature)
+{
+    auto it = find(creatures.begin(), creatures.end(), creature);
+    if(it == creatures.end())
+    {
+        return;
+    }
+
+    //the order of the creatures does not matter, so the last one takes the place of the removed one
+    *it = creatures.back();
+    creatures.pop_back();
+    invalidate_stats();
+
+    StatModifier modifier{};
+    if(creature->get_constant_modifier(modifier))
+    {
+        aggregatedModifier.attack -= modifier.attack;
+        aggregatedModifier.defense -= modifier.defense;
+    }
+    else
+    {
+        //the creature is not in customModifiers if it was pushed to creatures directly, instead of through add_creature
+        auto customIt = find(customModifiers.begin(), customModifiers.end(), creature);
+        if(customIt != customModifiers.end())
+        {
+            customModifiers.erase(customIt);
+        }
+    }
+}
+
 class Goblin : public Creature
 {
     public:
@@ -52,33 +340,12 @@ class Goblin : public Creature
         int get_attack() override 
         {
             //the result is stored internally in StatQuery, that has a given type
-            StatQuery q{StatQuery::attack, 0};
-            
-            //iterate through the chain of objects and query each one, including self, using same query object
-            //thus, each iterated object is queried for this object using each time the query defined above
-            for(auto&& creature : game.creatures)
-            {
-                creature->query(this, q);
-            }
-                
-            //return the result stored in the query object
-            return q.result;
+            return query_statistic(StatQuery::attack);
         }
         
         int get_defense() override 
         {
-            //the result is stored internally in StatQuery, that has a given type
-            StatQuery q{StatQuery::defense, 0};
-            
-            //iterate through the chain of objects and query each one, including self, using same query object
-            //thus, each iterated object is queried for this object using each time the query defined above
-            for(auto&& creature : game.creatures)
-            {
-                creature->query(this, q);
-            }
-                
-            //return the result stored in the query object
-            return q.result;
+            return query_statistic(StatQuery::defense);
         }
         
         void query(void *source, StatQuery &sq) override 
@@ -106,6 +373,19 @@ class Goblin : public Creature
                 }
             }
         }
+
+        //whatever the queried creature, a goblin adds +1 defense
+        //a derived class may override query with a bonus depending on the source, so only a Goblin itself is known to be constant
+        bool get_constant_modifier(StatModifier& modifier) const override
+        {
+            if(typeid(*this) != typeid(Goblin))
+            {
+                return false;
+            }
+
+            modifier = StatModifier{0, 1};
+            return true;
+        }
 };
 
 class GoblinKing : public Goblin
@@ -129,4 +409,16 @@ class GoblinKing : public Goblin
                 Goblin::query(source, sq);
             }
         }
+
+        //as a goblin, it adds +1 defense, and as a king, +1 attack
+        bool get_constant_modifier(StatModifier& modifier) const override
+        {
+            if(typeid(*this) != typeid(GoblinKing))
+            {
+                return false;
+            }
+
+            modifier = StatModifier{1, 1};
+            return true;
+        }
 };
\ No newline at end of file
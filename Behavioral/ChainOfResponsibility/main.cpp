@@ -79,5 +79,38 @@ int main()
     cout<<gk1.get_attack()<<" "<<gk1.get_defense()<<endl;
     cout<<goblin.get_attack()<<" "<<goblin.get_defense()<<endl;
 
+    //same stats, read in O(1) from the aggregates kept by the game
+    Game aggregatesGame{Game::QueryMode::Aggregates};
+    Goblin aggregatedGoblin{aggregatesGame};
+    GoblinKing aggregatedKing{aggregatesGame};
+
+    aggregatesGame.add_creature(&aggregatedGoblin);
+    aggregatesGame.add_creature(&aggregatedKing);
+
+    cout<<aggregatedKing.get_attack()<<" "<<aggregatedKing.get_defense()<<endl;
+    cout<<aggregatedGoblin.get_attack()<<" "<<aggregatedGoblin.get_defense()<<endl;
+
+    //the stats of all the creatures, computed in one pass, in the order of the creatures in game
+    Game::CreatureStats stats = game.compute_all_stats();
+    for(size_t idx{0}; idx < game.creatures.size(); ++idx)
+    {
+        cout<<stats.attack[idx]<<" "<<stats.defense[idx]<<(idx + 1 < game.creatures.size() ? ", " : "\n");
+    }
+
+    aggregatesGame.remove_creature(&aggregatedKing);
+    cout<<aggregatedGoblin.get_attack()<<" "<<aggregatedGoblin.get_defense()<<endl;
+
+    //the chain is walked by the first query only, the next ones return the cached result, till a creature is added or removed
+    Game cachingGame{Game::QueryMode::Chain, true};
+    Goblin cachedGoblin{cachingGame};
+    GoblinKing cachedKing{cachingGame};
+
+    cachingGame.add_creature(&cachedGoblin);
+    cout<<cachedGoblin.get_attack()<<" "<<cachedGoblin.get_defense()<<endl;
+    cout<<cachedGoblin.get_attack()<<" "<<cachedGoblin.get_defense()<<endl;
+
+    cachingGame.add_creature(&cachedKing);
+    cout<<cachedGoblin.get_attack()<<" "<<cachedGoblin.get_defense()<<endl;
+
     return 0;
 }
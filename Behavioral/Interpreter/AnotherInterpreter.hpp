@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <deque>
+#include <vector>
 #include <iostream>
 #include <stack>
+#include <charconv>
 
 class Token
 {
@@ -89,6 +92,32 @@ class Token
     std::string mContent;
 };
 
+/*
+* NumericToken is the lightweight counterpart of Token, used by the numeric lexing mode. Instead of owning a copy of
+* its text, it keeps a view into the input expression, whilst VALUE tokens also store the number already converted
+* to double, so the Parser never has to call std::stod on them. Being trivially copyable, no special member
+* functions are required and copying such tokens is as cheap as copying a few scalars.
+* The input expression must outlive the tokens created from it.
+*/
+class NumericToken
+{
+    public:
+    NumericToken() = default;
+    explicit NumericToken(const Token::TokenType& tokType, const std::string_view source, const double value = 0.0) : mTokenType{tokType},
+                                                                                                                   mSource{source},
+                                                                                                                   mValue{value}
+    {};
+    
+    Token::TokenType GetTokenType() const {return mTokenType;};
+    std::string_view GetSource() const {return mSource;};
+    double GetValue() const {return mValue;};
+    
+    private:
+    Token::TokenType mTokenType{Token::TokenType::VALUE};
+    std::string_view mSource;
+    double mValue{};
+};
+
 /*
 * Lexing class purpose is to encapsulate methods that convert an input string, containing math operations,
 * to a list of Tokens, with each value, operations sign and parenthesis, being identified classificated as such.
@@ -105,14 +134,23 @@ class Lexing
     
     bool CreateTokensList(const std::string& inputExpression);
     
-    std::deque<Token> GetTokenizedExpression() const
+    std::deque<Token> const& GetTokenizedExpression() const
     {
         return mVecTokenizedExpression;
     }
     
+    //numeric mode: the tokens hold views into inputExpression and VALUE tokens hold the parsed number
+    bool CreateNumericTokensList(std::string_view inputExpression);
+    
+    const std::vector<NumericToken>& GetNumericTokenizedExpression() const
+    {
+        return mVecNumericTokenizedExpression;
+    }
+    
     private:
     //members
     std::deque<Token> mVecTokenizedExpression;
+    std::vector<NumericToken> mVecNumericTokenizedExpression;
     
     //methods
     void ProcessOperator(const char signOperator);
@@ -218,7 +256,7 @@ bool Lexing::CreateTokensList(const std::string& inputExpression)
                 
                 //after all parenthesis are open, check if the next character is a MINUS, 
                 //as other operations do not make sense. If so, process it
-                if(inputExpression[idx].GetTokenType() == Token::TokenType::MINUS)
+                if(inputExpression[idx] == '-')
                 {
                     ProcessOperator(inputExpression[idx]);
                     prevOperatorNextIndex = idx+1;
@@ -283,6 +321,130 @@ bool Lexing::CreateTokensList(const std::string& inputExpression)
     return result;
 }
 
+/*
+* Numeric counterpart of the method above. It performs a single pass over the input, without building substrings:
+* operators and parenthesis are added as they are met, whilst values are converted with std::from_chars, which
+* also tells where the number ends, so the VALUE token gets a view of exactly the characters of the number.
+* A MINUS starting the expression or following a left parenthesis is added as a separate Token, same as above.
+* Returns false if the expression is ill-formed: unmatched parenthesis, characters that are neither operators nor numbers,
+* or Tokens out of order. Values and binary operators must alternate, starting and ending with a value: thus, an operator
+* cannot follow another operator (e.g. 2*-3), nor start or end the expression, and 2 values cannot be adjacent (e.g. 2 3).
+* A left parenthesis stands where a value is expected and a right parenthesis where an operator is expected.
+*/
+bool Lexing::CreateNumericTokensList(std::string_view inputExpression)
+{
+    size_t leftParenCount{0};
+    size_t rightParenCount{0};
+    //true at the start of the expression, after an operator and after a left parenthesis
+    bool isValueExpected{true};
+    //the MINUS is unary only at the start of the expression and after a left parenthesis
+    bool isUnaryMinusAllowed{true};
+    
+    mVecNumericTokenizedExpression.clear();
+    mVecNumericTokenizedExpression.reserve(inputExpression.size());
+    
+    for(size_t idx{0}, len = inputExpression.size(); idx < len; )
+    {
+        const char currentChar = inputExpression[idx];
+        
+        if(currentChar == ' ')
+        {
+            ++idx;
+        }
+        else if(IsOperator(currentChar))
+        {
+            Token::TokenType tokType{};
+            
+            switch(currentChar)
+            {
+                case '+':
+                    tokType = Token::TokenType::PLUS;
+                    break;
+                case '-':
+                    tokType = Token::TokenType::MINUS;
+                    break;
+                case '*':
+                    tokType = Token::TokenType::MUL;
+                    break;
+                case '/':
+                    tokType = Token::TokenType::DIV;
+                    break;
+                case '%':
+                    tokType = Token::TokenType::MOD;
+                    break;
+                case '(':
+                    tokType = Token::TokenType::LEFTPAREN;
+                    ++leftParenCount;
+                    break;
+                default:
+                    tokType = Token::TokenType::RIGHTPAREN;
+                    ++rightParenCount;
+                    break;
+            }
+            
+            if(leftParenCount < rightParenCount)
+            {
+                return false;
+            }
+            
+            if(tokType == Token::TokenType::LEFTPAREN)
+            {
+                if(!isValueExpected)
+                {
+                    return false;
+                }
+                
+                isUnaryMinusAllowed = true;
+            }
+            else if(tokType == Token::TokenType::RIGHTPAREN)
+            {
+                if(isValueExpected)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                if(isValueExpected && !(tokType == Token::TokenType::MINUS && isUnaryMinusAllowed))
+                {
+                    return false;
+                }
+                
+                isValueExpected = true;
+                isUnaryMinusAllowed = false;
+            }
+            
+            mVecNumericTokenizedExpression.emplace_back(tokType, inputExpression.substr(idx, 1));
+            ++idx;
+        }
+        else
+        {
+            if(!isValueExpected)
+            {
+                return false;
+            }
+            
+            double value{};
+            const char* valueBegin = inputExpression.data() + idx;
+            auto [valueEnd, errorCode] = std::from_chars(valueBegin, inputExpression.data() + len, value);
+            
+            if(errorCode != std::errc{})
+            {
+                return false;
+            }
+            
+            mVecNumericTokenizedExpression.emplace_back(Token::TokenType::VALUE, 
+                                                        inputExpression.substr(idx, valueEnd - valueBegin), 
+                                                        value);
+            idx += valueEnd - valueBegin;
+            isValueExpected = false;
+            isUnaryMinusAllowed = false;
+        }
+    }
+    
+    return !isValueExpected && leftParenCount == rightParenCount;
+}
+
 /*
 * Parser class' purpose is to encapsualte methods that compute expressions stored as list of tokens, specifically
 * in a deque<Token>. It is implemented as Singleton, does not store any data, with the result being returned from
@@ -294,6 +456,10 @@ class Parser
     Token ComputeExpressionNoParenthesis(const std::deque<Token>& tokenizedExpression);
     Token ComputeExpressionWithParenthesis(const std::deque<Token>& tokenizedExpression);
     
+    //numeric counterparts, working with the tokens of Lexing::CreateNumericTokensList
+    double ComputeExpressionNoParenthesis(std::vector<NumericToken>::const_iterator first, std::vector<NumericToken>::const_iterator last);
+    double ComputeExpressionWithParenthesis(const std::vector<NumericToken>& tokenizedExpression);
+    
     static Parser& GetInstance()
     {
         static Parser instance{};
@@ -487,3 +653,286 @@ Token Parser::ComputeExpressionWithParenthesis(const std::deque<Token>& tokenize
     
     return result;
 }
+
+/*
+* Numeric counterpart of ComputeExpressionNoParenthesis, computing the tokens in the range [first, last), which must be
+* well-formed, as checked by Lexing::CreateNumericTokensList.
+*
+* Approach: as the values are already numbers, there is no need to replace Tokens with the results of operations.
+* Instead, the 2 steps are performed in the same iteration, using 2 accumulators: the current term, which gathers the
+* results of *,/,% operations, and the sum of the terms computed so far. When + or - is met, the current term is
+* complete, so it is added to the sum, and the sign of the next term is recorded. When *,/,% is met, the current term
+* is combined with the next value. A MINUS starting the expression negates the first value, same as above.
+*/
+double Parser::ComputeExpressionNoParenthesis(std::vector<NumericToken>::const_iterator first, std::vector<NumericToken>::const_iterator last)
+{
+    double sum{0.0};
+    double currentTerm{0.0};
+    double nextTermSign{1.0};
+    
+    if(first != last && first->GetTokenType() == Token::TokenType::MINUS)
+    {
+        nextTermSign = -1.0;
+        ++first;
+    }
+    
+    if(first != last)
+    {
+        currentTerm = nextTermSign * first->GetValue();
+        ++first;
+    }
+    
+    //operators are always followed by a value, so the tokens are processed in pairs
+    for( ; first != last && (first + 1) != last; first += 2)
+    {
+        const double nextValue = (first + 1)->GetValue();
+        
+        switch(first->GetTokenType())
+        {
+            case Token::TokenType::MUL:
+                currentTerm *= nextValue;
+                break;
+            case Token::TokenType::DIV:
+                currentTerm /= nextValue;
+                break;
+            case Token::TokenType::MOD:
+                currentTerm = static_cast<int>(currentTerm) % static_cast<int>(nextValue);
+                break;
+            case Token::TokenType::PLUS:
+                sum += currentTerm;
+                currentTerm = nextValue;
+                break;
+            case Token::TokenType::MINUS:
+                sum += currentTerm;
+                currentTerm = -nextValue;
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return sum + currentTerm;
+}
+
+/*
+* Numeric counterpart of ComputeExpressionWithParenthesis.
+*
+* Approach: the tokens are copied, one by one, to another list that acts as a stack, with the indeces of left parenthesis
+* being stacked, as well. When a right parenthesis is met, the tokens following the last left parenthesis are all on top
+* of the stack and none of them is a parenthesis. Thus, they are computed in place, then they are popped, together with
+* the left parenthesis, and replaced by a VALUE token holding the result. There is no need to copy subexpressions
+* or to erase Tokens from the middle of the list.
+*/
+double Parser::ComputeExpressionWithParenthesis(const std::vector<NumericToken>& tokenizedExpression)
+{
+    std::vector<NumericToken> reducedExpression{};
+    std::stack<size_t> stackIdLastLeftParen{};
+    
+    reducedExpression.reserve(tokenizedExpression.size());
+    
+    for(const NumericToken& token : tokenizedExpression)
+    {
+        if(token.GetTokenType() == Token::TokenType::LEFTPAREN)
+        {
+            stackIdLastLeftParen.push(reducedExpression.size());
+            reducedExpression.push_back(token);
+        }
+        else if(token.GetTokenType() == Token::TokenType::RIGHTPAREN)
+        {
+            size_t idLastLeftParen = stackIdLastLeftParen.top();
+            stackIdLastLeftParen.pop();
+            
+            double subExpressionResult = ComputeExpressionNoParenthesis(reducedExpression.cbegin() + idLastLeftParen + 1, 
+                                                                        reducedExpression.cend());
+            
+            reducedExpression.resize(idLastLeftParen);
+            reducedExpression.emplace_back(Token::TokenType::VALUE, std::string_view{}, subExpressionResult);
+        }
+        else
+        {
+            reducedExpression.push_back(token);
+        }
+    }
+    
+    return ComputeExpressionNoParenthesis(reducedExpression.cbegin(), reducedExpression.cend());
+}
+
+/*
+* ShuntingYardParser is an alternative to the Parser above, selectable by using its instance instead of Parser::GetInstance(),
+* as it exposes a method with the same signature for the numeric tokens. Same as Parser, it is a Singleton that does not store any data.
+*
+* Parser reduces the list of Tokens in place, scanning it again for each precedence level and for each pair of parenthesis,
+* which becomes quadratic for long or deeply nested expressions. Instead, this parser uses Dijkstra's shunting-yard algorithm
+* to convert the list of Tokens, in one pass, into postfix (reverse polish) order, where the order of operations is given by
+* the position of the operators: 2*(3+4) becomes 2 3 4 + *. The postfix list is then computed in another single pass,
+* with a stack of values. It can also be stored and computed several times, without lexing and parsing the expression again.
+*/
+class ShuntingYardParser
+{
+    public:
+    std::vector<NumericToken> ConvertToPostfix(const std::vector<NumericToken>& tokenizedExpression);
+    double ComputePostfixExpression(const std::vector<NumericToken>& postfixExpression);
+    
+    double ComputeExpressionWithParenthesis(const std::vector<NumericToken>& tokenizedExpression)
+    {
+        return ComputePostfixExpression(ConvertToPostfix(tokenizedExpression));
+    }
+    
+    static ShuntingYardParser& GetInstance()
+    {
+        static ShuntingYardParser instance{};
+        
+        return instance;
+    }
+    
+    private:
+    ShuntingYardParser() = default;
+    ~ShuntingYardParser() = default;
+    ShuntingYardParser(const ShuntingYardParser&) = delete;
+    ShuntingYardParser& operator=(const ShuntingYardParser&) = delete;
+    ShuntingYardParser(ShuntingYardParser&&) = delete;
+    ShuntingYardParser& operator=(ShuntingYardParser&&) = delete;
+    
+    static int GetPrecedence(const Token::TokenType& tokType)
+    {
+        int result{0};
+        
+        if(tokType == Token::TokenType::PLUS || tokType == Token::TokenType::MINUS)
+        {
+            result = 1;
+        }
+        else if(tokType == Token::TokenType::MUL || tokType == Token::TokenType::DIV || tokType == Token::TokenType::MOD)
+        {
+            result = 2;
+        }
+        
+        return result;
+    }
+};
+
+/*
+* Approach: iterate over the list of Tokens once. Values are added to the output as they are met. An operator is stacked, but
+* firstly the stacked operators having greater or equal precedence are popped to the output, as they must be computed before it
+* (all operators are left associative). A left parenthesis is stacked as a barrier, whilst a right parenthesis pops operators
+* to the output till the matching left parenthesis is found. In the end, the remaining operators are popped to the output.
+* A MINUS starting the expression or following a left parenthesis is unary, so it is converted to 0-value, same as Parser does,
+* by adding a 0 VALUE Token to the output before stacking the MINUS.
+*/
+std::vector<NumericToken> ShuntingYardParser::ConvertToPostfix(const std::vector<NumericToken>& tokenizedExpression)
+{
+    std::vector<NumericToken> result{};
+    std::vector<NumericToken> operatorsStack{};
+    bool isOperandExpected{true};
+    
+    result.reserve(tokenizedExpression.size() + 1);
+    
+    for(const NumericToken& token : tokenizedExpression)
+    {
+        switch(token.GetTokenType())
+        {
+            case Token::TokenType::VALUE:
+            {
+                result.push_back(token);
+                isOperandExpected = false;
+                break;
+            }
+            case Token::TokenType::LEFTPAREN:
+            {
+                operatorsStack.push_back(token);
+                isOperandExpected = true;
+                break;
+            }
+            case Token::TokenType::RIGHTPAREN:
+            {
+                while(!operatorsStack.empty() && operatorsStack.back().GetTokenType() != Token::TokenType::LEFTPAREN)
+                {
+                    result.push_back(operatorsStack.back());
+                    operatorsStack.pop_back();
+                }
+                
+                //drop the matching left parenthesis
+                if(!operatorsStack.empty())
+                {
+                    operatorsStack.pop_back();
+                }
+                isOperandExpected = false;
+                break;
+            }
+            default:
+            {
+                if(isOperandExpected && token.GetTokenType() == Token::TokenType::MINUS)
+                {
+                    result.emplace_back(Token::TokenType::VALUE, std::string_view{}, 0.0);
+                }
+                
+                while(!operatorsStack.empty() && GetPrecedence(operatorsStack.back().GetTokenType()) >= GetPrecedence(token.GetTokenType()))
+                {
+                    result.push_back(operatorsStack.back());
+                    operatorsStack.pop_back();
+                }
+                
+                operatorsStack.push_back(token);
+                isOperandExpected = true;
+                break;
+            }
+        }
+    }
+    
+    result.insert(result.end(), operatorsStack.rbegin(), operatorsStack.rend());
+    
+    return result;
+}
+
+/*
+* Iterate over the postfix list of Tokens: values are pushed to a stack, whilst an operator pops its 2 operands, with the
+* right hand side one being on top, and pushes back the result. In the end, the stack holds only the expression's result.
+* The operations are computed the same as in Parser::ComputeExpressionNoParenthesis.
+*/
+double ShuntingYardParser::ComputePostfixExpression(const std::vector<NumericToken>& postfixExpression)
+{
+    std::vector<double> valuesStack{};
+    
+    valuesStack.reserve(postfixExpression.size());
+    
+    for(const NumericToken& token : postfixExpression)
+    {
+        if(token.GetTokenType() == Token::TokenType::VALUE)
+        {
+            valuesStack.push_back(token.GetValue());
+            continue;
+        }
+        
+        //ill-formed expression: an operator lacks its operands
+        if(valuesStack.size() < 2)
+        {
+            return 0.0;
+        }
+        
+        const double rhs = valuesStack.back();
+        valuesStack.pop_back();
+        double& lhs = valuesStack.back();
+        
+        switch(token.GetTokenType())
+        {
+            case Token::TokenType::PLUS:
+                lhs += rhs;
+                break;
+            case Token::TokenType::MINUS:
+                lhs -= rhs;
+                break;
+            case Token::TokenType::MUL:
+                lhs *= rhs;
+                break;
+            case Token::TokenType::DIV:
+                lhs /= rhs;
+                break;
+            case Token::TokenType::MOD:
+                lhs = static_cast<int>(lhs) % static_cast<int>(rhs);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return valuesStack.empty() ? 0.0 : valuesStack.back();
+}
@@ -0,0 +1,95 @@
+#include "../ExpressionProcessor.hpp"
+#include "../CompiledExpression.hpp"
+#include "../ExpressionOptimizer.hpp"
+#include "../ClosureExpression.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+
+/*
+* Microbenchmark of the ways an expression can be evaluated repeatedly, with different variables values:
+*   - ExpressionProcessor::Calculate, which lexes and parses the expression at each call
+*   - CompiledExpression::eval, which interprets the postfix instructions, with and without optimizations
+*   - ClosureExpression::eval, which calls the closures built from the (optimized) program
+* Build it together with the interpreter's sources, with optimizations, e.g.:
+*   g++ -std=c++17 -O2 ClosureBackend.cpp ../ExpressionProcessor.cpp ../LexingToken.cpp ../CompiledExpression.cpp
+*       ../ExpressionOptimizer.cpp ../ClosureExpression.cpp
+*/
+
+//returns the average duration, in nanoseconds, of one evaluation
+double Measure(const function<double(double)>& evaluate, const size_t evaluationsCount, double& checksum)
+{
+    auto start = chrono::steady_clock::now();
+
+    checksum = 0;
+    for(size_t idx{0}; idx < evaluationsCount; ++idx)
+    {
+        //the value of x changes at each evaluation, so the results cannot be reused
+        checksum += evaluate(static_cast<double>(idx % 100));
+    }
+
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+
+    return elapsed.count() / evaluationsCount;
+}
+
+int main()
+{
+    const vector<string> expressions{"x*y",
+                                     "2*x+y*3",
+                                     "x*2.5/(y-1)+4*(7.5-x)-(x+y)*(x-y)",
+                                     "1+2*3-4/2+x*(5+6*7)-8/(9-y)+(x+y)*(x+y)-10*x*(y+1)"};
+    ExpressionProcessor ep{};
+    ep.verbose = false;
+    ep.variables['y'] = 3.0;
+
+    cout<<setw(10)<<"expression"<<setw(14)<<"Calculate ns"<<setw(14)<<"compiled ns"
+        <<setw(15)<<"optimized ns"<<setw(13)<<"closure ns"<<endl;
+
+    for(size_t exprIdx{0}; exprIdx < expressions.size(); ++exprIdx)
+    {
+        const string& expression = expressions[exprIdx];
+        CompiledExpression compiled = CompiledExpression::compile(expression);
+        CompiledExpression optimized = ExpressionOptimizer::optimize(compiled);
+        ClosureExpression closure{optimized};
+
+        //the variables are used in expressions in the order x, y, so these are the slots' values
+        double slotValues[2]{0.0, ep.variables['y']};
+        double calculateChecksum{}, compiledChecksum{}, optimizedChecksum{}, closureChecksum{};
+
+        double calculateDuration = Measure([&ep, &expression](double x)
+                                           {
+                                               ep.variables['x'] = x;
+                                               return ep.Calculate(expression);
+                                           }, 20000, calculateChecksum);
+
+        double compiledDuration = Measure([&compiled, &slotValues](double x)
+                                          {
+                                              slotValues[0] = x;
+                                              return compiled.eval(slotValues);
+                                          }, 2000000, compiledChecksum);
+
+        double optimizedDuration = Measure([&optimized, &slotValues](double x)
+                                           {
+                                               slotValues[0] = x;
+                                               return optimized.eval(slotValues);
+                                           }, 2000000, optimizedChecksum);
+
+        double closureDuration = Measure([&closure, &slotValues](double x)
+                                         {
+                                             slotValues[0] = x;
+                                             return closure.eval(slotValues);
+                                         }, 2000000, closureChecksum);
+
+        cout<<setw(10)<<exprIdx<<setw(14)<<calculateDuration<<setw(14)<<compiledDuration
+            <<setw(15)<<optimizedDuration<<setw(13)<<closureDuration<<endl;
+
+        if(compiledChecksum != closureChecksum)
+        {
+            cout<<"  checksums differ: "<<compiledChecksum<<" "<<optimizedChecksum<<" "<<closureChecksum<<endl;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
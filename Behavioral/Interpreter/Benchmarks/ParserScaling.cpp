@@ -0,0 +1,133 @@
+#include "../AnotherInterpreter.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <utility>
+
+/*
+* Standalone benchmark of the parsers in AnotherInterpreter.hpp, showing how their running time scales with the
+* number of Tokens in expression. It is a separate program, as AnotherInterpreter.hpp cannot be included together
+* with the headers used by main.cpp. Build it with optimizations, e.g.: g++ -std=c++17 -O2 ParserScaling.cpp
+*
+* Two shapes of expressions are generated:
+*   - flat: 1+2*3-4/5+6*7-... with no parenthesis, so all the Tokens are scanned for each precedence level
+*   - nested: ((((1+2)*3-4)+5)*6...), so each pair of parenthesis encloses all the previous ones
+* Before measuring, it checks that the numeric lexer rejects ill-formed expressions, which the parsers would compute wrongly.
+*/
+
+std::string CreateFlatExpression(const size_t tokensCount)
+{
+    const char operators[]{'+', '*', '-', '/'};
+    std::string result{"1"};
+    
+    for(size_t idx{1}; 2*idx < tokensCount; ++idx)
+    {
+        result += operators[idx % 4];
+        result += std::to_string(idx % 9 + 1);
+    }
+    
+    return result;
+}
+
+std::string CreateNestedExpression(const size_t tokensCount)
+{
+    const char operators[]{'+', '*', '-'};
+    //each level adds 4 Tokens: (, operator, value and )
+    const size_t levels = tokensCount / 4;
+    std::string result(levels, '(');
+    
+    result += "1";
+    for(size_t idx{0}; idx < levels; ++idx)
+    {
+        result += operators[idx % 3];
+        result += std::to_string(idx % 9 + 1);
+        result += ')';
+    }
+    
+    return result;
+}
+
+//returns the average duration, in microseconds, of computing the expression, lexing included
+double Measure(const std::function<double()>& compute, double& result)
+{
+    size_t repetitions{0};
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed{};
+    
+    //repeat fast computations, so the measurement lasts at least 100ms
+    do
+    {
+        result = compute();
+        ++repetitions;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    while(elapsed.count() < 100000.0);
+    
+    return elapsed.count() / repetitions;
+}
+
+int main()
+{
+    const std::pair<std::string_view, bool> expressionsValidity[]{{"2*-3", false}, {"*2", false}, {"2+", false}, {"2 3", false},
+                                                                    {"(2)(3)", false}, {"2(3)", false}, {"()", false}, {"--2", false},
+                                                                    {"-2", true}, {"(-2)*3", true}, {"-(2+3)*4", true}};
+    
+    for(const auto& [expression, isWellFormed] : expressionsValidity)
+    {
+        Lexing lexer{};
+        
+        if(lexer.CreateNumericTokensList(expression) != isWellFormed)
+        {
+            std::cout<<"  "<<expression<<(isWellFormed ? " is rejected" : " is accepted")<<" by the numeric lexer"<<std::endl;
+        }
+    }
+    
+    std::cout<<std::setw(8)<<"shape"<<std::setw(10)<<"tokens"
+             <<std::setw(22)<<"Parser (Token) us"
+             <<std::setw(26)<<"Parser (NumericToken) us"
+             <<std::setw(22)<<"ShuntingYard us"<<std::endl;
+    
+    for(const bool isNested : {false, true})
+    {
+        for(const size_t tokensCount : {1000, 2500, 5000, 10000})
+        {
+            const std::string expression = isNested ? CreateNestedExpression(tokensCount) : CreateFlatExpression(tokensCount);
+            double stringResult{}, numericResult{}, shuntingYardResult{};
+            
+            double stringDuration = Measure([&expression]()
+                                            {
+                                                Lexing lexer{};
+                                                lexer.CreateTokensList(expression);
+                                                return std::stod(Parser::GetInstance().ComputeExpressionWithParenthesis(lexer.GetTokenizedExpression()).GetContent());
+                                            }, stringResult);
+            
+            double numericDuration = Measure([&expression]()
+                                            {
+                                                Lexing lexer{};
+                                                lexer.CreateNumericTokensList(expression);
+                                                return Parser::GetInstance().ComputeExpressionWithParenthesis(lexer.GetNumericTokenizedExpression());
+                                            }, numericResult);
+            
+            double shuntingYardDuration = Measure([&expression]()
+                                            {
+                                                Lexing lexer{};
+                                                lexer.CreateNumericTokensList(expression);
+                                                return ShuntingYardParser::GetInstance().ComputeExpressionWithParenthesis(lexer.GetNumericTokenizedExpression());
+                                            }, shuntingYardResult);
+            
+            std::cout<<std::setw(8)<<(isNested ? "nested" : "flat")<<std::setw(10)<<tokensCount
+                     <<std::setw(22)<<stringDuration
+                     <<std::setw(26)<<numericDuration
+                     <<std::setw(22)<<shuntingYardDuration<<std::endl;
+            
+            //the results of the numeric parsers may differ slightly from the string one, as std::to_string rounds to 6 decimals
+            if(numericResult != shuntingYardResult)
+            {
+                std::cout<<"  results differ: "<<stringResult<<" "<<numericResult<<" "<<shuntingYardResult<<std::endl;
+            }
+        }
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "ClosureExpression.hpp"
+
+#include <algorithm>
+
+template<Operation::OperationType Type>
+ClosureExpression::Evaluator ClosureExpression::makeOperation(ClosureNode&& lhs, ClosureNode&& rhs)
+{
+    const size_t lhsSlot = lhs.variableSlot;
+    const size_t rhsSlot = rhs.variableSlot;
+    const double lhsConstant = lhs.constant;
+    const double rhsConstant = rhs.constant;
+
+    if(lhs.type == Instruction::pushVariable && rhs.type == Instruction::pushVariable)
+    {
+        return [lhsSlot, rhsSlot](const double* slotValues, double*)
+        {
+            return Operation::apply(Type, slotValues[lhsSlot], slotValues[rhsSlot]);
+        };
+    }
+
+    if(lhs.type == Instruction::pushVariable && rhs.type == Instruction::pushConstant)
+    {
+        return [lhsSlot, rhsConstant](const double* slotValues, double*)
+        {
+            return Operation::apply(Type, slotValues[lhsSlot], rhsConstant);
+        };
+    }
+
+    if(lhs.type == Instruction::pushConstant && rhs.type == Instruction::pushVariable)
+    {
+        return [lhsConstant, rhsSlot](const double* slotValues, double*)
+        {
+            return Operation::apply(Type, lhsConstant, slotValues[rhsSlot]);
+        };
+    }
+
+    //general shape: at least one of the operands is computed by its own closure
+    //lhs is computed first, as the order of evaluation of the arguments is unspecified, whilst the temporaries rely on it
+    return [lhsEvaluator = move(lhs.evaluator), rhsEvaluator = move(rhs.evaluator)](const double* slotValues, double* temporaries)
+    {
+        const double lhsValue = lhsEvaluator(slotValues, temporaries);
+
+        return Operation::apply(Type, lhsValue, rhsEvaluator(slotValues, temporaries));
+    };
+}
+
+//turns the operation type, known only at run time, into a template argument
+ClosureExpression::ClosureNode ClosureExpression::makeOperation(const Operation::OperationType operationType, ClosureNode&& lhs, ClosureNode&& rhs)
+{
+    ClosureNode result{Instruction::applyOperation, {}, {}, {}};
+
+    switch(operationType)
+    {
+        case Operation::add:
+            result.evaluator = makeOperation<Operation::add>(move(lhs), move(rhs));
+            break;
+        case Operation::sub:
+            result.evaluator = makeOperation<Operation::sub>(move(lhs), move(rhs));
+            break;
+        case Operation::mul:
+            result.evaluator = makeOperation<Operation::mul>(move(lhs), move(rhs));
+            break;
+        case Operation::div:
+            result.evaluator = makeOperation<Operation::div>(move(lhs), move(rhs));
+            break;
+        default:
+            result.evaluator = [](const double*, double*){return 0.0;};
+            break;
+    }
+
+    return result;
+}
+
+size_t ClosureExpression::getTreeDepth(const CompiledExpression& compiled)
+{
+    //the depths of the subtrees whose values would be on the evaluation stack
+    vector<size_t> depthsStack{};
+    size_t result{0};
+
+    for(const Instruction& instruction : compiled.getProgram())
+    {
+        switch(instruction.type)
+        {
+            case Instruction::pushConstant:
+            case Instruction::pushVariable:
+            case Instruction::loadTemporary:
+                depthsStack.push_back(1);
+                break;
+            case Instruction::negate:
+            case Instruction::storeTemporary:
+                ++depthsStack.back();
+                break;
+            case Instruction::applyOperation:
+            {
+                const size_t rhsDepth = depthsStack.back();
+                depthsStack.pop_back();
+                depthsStack.back() = max(depthsStack.back(), rhsDepth) + 1;
+                break;
+            }
+        }
+
+        result = max(result, depthsStack.back());
+    }
+
+    return result;
+}
+
+/*
+* The closures are built by simulating the evaluation of the program, with a stack of nodes instead of a stack of values.
+* Constants and variables get their own closures as well, used when they are operands of a general shaped operation
+* or when the whole expression is a single value.
+*/
+ClosureExpression::ClosureExpression(const CompiledExpression& compiled)
+{
+    if(!compiled.isValid())
+    {
+        return;
+    }
+
+    variableNames = compiled.getVariableNames();
+
+    //the depth is checked before building any closure, as destroying the closures of a deep tree would overflow the stack too
+    if(getTreeDepth(compiled) > maxClosureDepth)
+    {
+        fallback = compiled;
+        return;
+    }
+
+    vector<ClosureNode> nodesStack{};
+
+    for(const Instruction& instruction : compiled.getProgram())
+    {
+        switch(instruction.type)
+        {
+            case Instruction::pushConstant:
+            {
+                ClosureNode node{Instruction::pushConstant, instruction.constant, {}, {}};
+                node.evaluator = [constant = instruction.constant](const double*, double*){return constant;};
+                nodesStack.push_back(move(node));
+                break;
+            }
+            case Instruction::pushVariable:
+            {
+                ClosureNode node{Instruction::pushVariable, {}, instruction.variableSlot, {}};
+                node.evaluator = [slot = instruction.variableSlot](const double* slotValues, double*){return slotValues[slot];};
+                nodesStack.push_back(move(node));
+                break;
+            }
+            case Instruction::negate:
+            {
+                ClosureNode node{Instruction::negate, {}, {}, {}};
+                node.evaluator = [operand = move(nodesStack.back().evaluator)](const double* slotValues, double* temporaries)
+                {
+                    return -operand(slotValues, temporaries);
+                };
+                nodesStack.back() = move(node);
+                break;
+            }
+            case Instruction::applyOperation:
+            {
+                ClosureNode rhs = move(nodesStack.back());
+                nodesStack.pop_back();
+                nodesStack.back() = makeOperation(instruction.operationType, move(nodesStack.back()), move(rhs));
+                break;
+            }
+            //the stored node stays on the stack, computing its value once and keeping it for the later loads
+            case Instruction::storeTemporary:
+            {
+                ClosureNode node{Instruction::storeTemporary, {}, {}, {}};
+                node.evaluator = [operand = move(nodesStack.back().evaluator), slot = instruction.temporarySlot]
+                                 (const double* slotValues, double* temporaries)
+                {
+                    return temporaries[slot] = operand(slotValues, temporaries);
+                };
+                nodesStack.back() = move(node);
+                break;
+            }
+            case Instruction::loadTemporary:
+            {
+                ClosureNode node{Instruction::loadTemporary, {}, {}, {}};
+                node.evaluator = [slot = instruction.temporarySlot](const double*, double* temporaries){return temporaries[slot];};
+                nodesStack.push_back(move(node));
+                break;
+            }
+        }
+    }
+
+    evaluator = move(nodesStack.back().evaluator);
+    temporariesCount = compiled.getTemporariesCount();
+}
+
+double ClosureExpression::eval(const double* slotValues) const
+{
+    if(!evaluator)
+    {
+        //evaluates to 0 if the expression is not valid, same as an empty evaluator
+        return fallback.eval(slotValues);
+    }
+
+    //the temporaries are written and read within a single evaluation, so a buffer per thread is enough
+    thread_local vector<double> temporaries{};
+
+    if(temporaries.size() < temporariesCount)
+    {
+        temporaries.resize(temporariesCount);
+    }
+
+    return evaluator(slotValues, temporaries.data());
+}
+
+double ClosureExpression::eval(const map<char, double>& bindings) const
+{
+    thread_local vector<double> slotValues{};
+
+    if(slotValues.size() < variableNames.size())
+    {
+        slotValues.resize(variableNames.size());
+    }
+
+    for(size_t slot{0}; slot < variableNames.size(); ++slot)
+    {
+        auto it = bindings.find(variableNames[slot]);
+
+        if(it == bindings.end())
+        {
+            return 0;
+        }
+
+        slotValues[slot] = it->second;
+    }
+
+    return eval(slotValues.data());
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "CompiledExpression.hpp"
+
+/*
+* 6. Compiling to closures: an alternative backend to the instructions' interpreter of CompiledExpression, and to the tree of
+* Elements evaluated with virtual eval(). Each node of the expression becomes a lambda that captures, by value, the lambdas
+* of its operands. Evaluating the expression is calling the lambda of the root node, which calls those of its operands, and so on.
+*
+* The operation type is not checked at evaluation time: it is a template parameter of the lambda's factory, so the compiler
+* reduces Operation::apply to the single arithmetic operation for each instantiation. In addition, the most common shapes of
+* nodes are handled by dedicated lambdas, which read their operands directly, without calling other lambdas:
+*   - variable op variable, variable op constant, constant op variable
+* For example, 2*x+y*z is compiled to an addition lambda calling a (constant mul variable) lambda and a (variable mul variable) one.
+*
+* The closures are built from the program of a CompiledExpression, which may be optimized. The temporaries of an optimized
+* program are kept as well: the closure of a stored subexpression writes its value in an array of temporaries, the first time
+* it is met, and each later use is a closure reading that value. The closures of the operands of an operation are called
+* in the order of the program, lhs first, so a temporary is always written before it is read, as in CompiledExpression.
+* The closures are moved, not copied, into the closures using them, so building them takes linear time.
+*
+* Evaluating and destroying the closures is recursive, one call per level of the expression's tree, so a deep tree, such as
+* a long flat sum x+1+1+..., would overflow the call stack. Thus, the closures are built only for trees that are at most
+* maxClosureDepth levels deep. Deeper expressions keep the CompiledExpression and are evaluated by its instructions' loop.
+*/
+class ClosureExpression
+{
+    public:
+    using Evaluator = function<double(const double* slotValues, double* temporaries)>;
+
+    ClosureExpression() = default;
+    explicit ClosureExpression(const CompiledExpression& compiled);
+
+    //a level takes less than 400 bytes of stack, even without optimizations, so a thread needs less than 400KB of stack
+    static constexpr size_t maxClosureDepth{1000};
+
+    bool isValid() const {return static_cast<bool>(evaluator) || fallback.isValid();};
+    //false if the expression is deeper than maxClosureDepth, hence evaluated by CompiledExpression
+    bool usesClosures() const {return static_cast<bool>(evaluator);};
+    const vector<char>& getVariableNames() const {return variableNames;};
+
+    //same arguments and results as the eval methods of CompiledExpression
+    double eval(const double* slotValues) const;
+
+    double eval(const map<char, double>& bindings) const;
+
+    private:
+    //an operand, as seen whilst building the closures: constants and variables are kept as such, so the shapes can be detected
+    struct ClosureNode
+    {
+        Instruction::InstructionType type;
+        double constant{};
+        size_t variableSlot{};
+        Evaluator evaluator;
+    };
+
+    Evaluator evaluator;
+    vector<char> variableNames;
+    size_t temporariesCount{};
+    //only valid when the expression is too deep for closures
+    CompiledExpression fallback;
+
+    //the number of levels of the tree whose postfix form is the program, a temporary's load counting as a leaf
+    static size_t getTreeDepth(const CompiledExpression& compiled);
+
+    static ClosureNode makeOperation(const Operation::OperationType operationType, ClosureNode&& lhs, ClosureNode&& rhs);
+
+    template<Operation::OperationType Type>
+    static Evaluator makeOperation(ClosureNode&& lhs, ClosureNode&& rhs);
+};
\ No newline at end of file
@@ -0,0 +1,481 @@
+#include "CompiledExpression.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+/*
+* Pushing a value increases the depth of the evaluation stack by one, whilst an operation pops 2 values
+* and pushes one. Negation and storing a temporary do not change the depth. The maximum depth reached whilst emitting the program
+* is the size of the stack required by eval.
+*/
+void CompiledExpression::emit(const Instruction& instruction)
+{
+    if(instruction.type == Instruction::pushConstant || instruction.type == Instruction::pushVariable ||
+       instruction.type == Instruction::loadTemporary)
+    {
+        ++currentDepth;
+        stackDepth = max(stackDepth, currentDepth);
+    }
+    else if(instruction.type == Instruction::applyOperation)
+    {
+        --currentDepth;
+    }
+
+    program.push_back(instruction);
+}
+
+size_t CompiledExpression::getVariableSlot(const char variableName)
+{
+    auto it = find(variableNames.begin(), variableNames.end(), variableName);
+
+    if(it != variableNames.end())
+    {
+        return it - variableNames.begin();
+    }
+
+    variableNames.push_back(variableName);
+
+    return variableNames.size() - 1;
+}
+
+int CompiledExpression::getPrecedence(const Token::Type tokenType)
+{
+    int result{0};
+
+    if(tokenType == Token::add || tokenType == Token::substract)
+    {
+        result = 1;
+    }
+    else if(tokenType == Token::multiply || tokenType == Token::divide)
+    {
+        result = 2;
+    }
+
+    return result;
+}
+
+void CompiledExpression::emitOperation(const Token::Type tokenType)
+{
+    Instruction operation{Instruction::applyOperation};
+
+    switch(tokenType)
+    {
+        case Token::add:
+            operation.operationType = Operation::add;
+            break;
+        case Token::substract:
+            operation.operationType = Operation::sub;
+            break;
+        case Token::multiply:
+            operation.operationType = Operation::mul;
+            break;
+        default:
+            operation.operationType = Operation::div;
+            break;
+    }
+
+    emit(operation);
+}
+
+/*
+* The parsing follows the grammar below, where the operations of the same precedence are computed from left to right:
+*   sum     := product (('+' | '-') product)*
+*   product := factor (('*' | '/') factor)*
+*   factor  := '-' factor | number | variable | '(' sum ')'
+* It is done by the shunting-yard algorithm, with an explicit stack of pending operators, so that the input, which may
+* be untrusted, cannot overflow the call stack, as recursive descent would do with deeply nested parenthesis or long
+* chains of unary minus. Operands are emitted as they are met. A binary operator firstly emits the stacked operators of
+* greater or equal precedence, which must be computed before it, then it is stacked. A left parenthesis is stacked as a
+* barrier, whilst a right parenthesis emits the operators stacked after the matching left parenthesis. A unary minus applies
+* to the factor following it, so it is stacked and emitted as soon as that factor is complete, that is after a number, a variable
+* or a right parenthesis. This yields the postfix form, in the same order as recursive descent would emit it.
+*
+* The tokens alternate between operands, possibly preceded by unary minus and left parenthesis, and binary operators,
+* possibly preceded by right parenthesis. Any other sequence makes the expression ill-formed.
+*/
+bool CompiledExpression::compileTokens(const vector<Token>& tokens)
+{
+    struct PendingOperator
+    {
+        Token::Type type;
+        //substract is both the unary minus and the binary operator
+        bool isUnary;
+    };
+    vector<PendingOperator> pendingOperators{};
+    bool isOperandExpected{true};
+
+    //emits the unary minus applying to the factor that has just been completed
+    auto completeFactor = [this, &pendingOperators]()
+    {
+        while(!pendingOperators.empty() && pendingOperators.back().isUnary)
+        {
+            emit(Instruction{Instruction::negate});
+            pendingOperators.pop_back();
+        }
+    };
+
+    for(const Token& token : tokens)
+    {
+        if(isOperandExpected)
+        {
+            switch(token.type)
+            {
+                case Token::substract:
+                {
+                    pendingOperators.push_back({token.type, true});
+                    break;
+                }
+                case Token::lparen:
+                {
+                    pendingOperators.push_back({token.type, false});
+                    break;
+                }
+                case Token::floatingPointValue:
+                {
+                    Instruction push{Instruction::pushConstant};
+
+                    //the number is made of digits only, but it may be too large for a double
+                    try
+                    {
+                        push.constant = stod(token.tokenizedItem);
+                    }
+                    catch(const out_of_range&)
+                    {
+                        return false;
+                    }
+
+                    emit(push);
+                    completeFactor();
+                    isOperandExpected = false;
+                    break;
+                }
+                case Token::variable:
+                {
+                    //compound variables are not supported, as variables map uses char keys
+                    if(token.tokenizedItem.size() != 1)
+                    {
+                        return false;
+                    }
+
+                    Instruction push{Instruction::pushVariable};
+                    push.variableSlot = getVariableSlot(token.tokenizedItem[0]);
+                    emit(push);
+                    completeFactor();
+                    isOperandExpected = false;
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        else
+        {
+            switch(token.type)
+            {
+                case Token::add:
+                case Token::substract:
+                case Token::multiply:
+                case Token::divide:
+                {
+                    while(!pendingOperators.empty() && getPrecedence(pendingOperators.back().type) >= getPrecedence(token.type))
+                    {
+                        emitOperation(pendingOperators.back().type);
+                        pendingOperators.pop_back();
+                    }
+
+                    pendingOperators.push_back({token.type, false});
+                    isOperandExpected = true;
+                    break;
+                }
+                case Token::rparen:
+                {
+                    while(!pendingOperators.empty() && pendingOperators.back().type != Token::lparen)
+                    {
+                        emitOperation(pendingOperators.back().type);
+                        pendingOperators.pop_back();
+                    }
+
+                    //unmatched right parenthesis
+                    if(pendingOperators.empty())
+                    {
+                        return false;
+                    }
+
+                    pendingOperators.pop_back();
+                    completeFactor();
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    //an operand is expected, but the expression ended
+    if(isOperandExpected)
+    {
+        return false;
+    }
+
+    for( ; !pendingOperators.empty(); pendingOperators.pop_back())
+    {
+        //unmatched left parenthesis
+        if(pendingOperators.back().type == Token::lparen)
+        {
+            return false;
+        }
+
+        emitOperation(pendingOperators.back().type);
+    }
+
+    return true;
+}
+
+CompiledExpression CompiledExpression::compile(string_view expression)
+{
+    CompiledExpression result{};
+
+    LexingProcessor lexProc{};
+    vector<Token> tokens = lexProc.lexingInputText(expression);
+
+    result.valid = !tokens.empty() && result.compileTokens(tokens);
+
+    if(!result.valid)
+    {
+        result.program.clear();
+        result.variableNames.clear();
+        result.stackDepth = 0;
+    }
+
+    return result;
+}
+
+double CompiledExpression::eval(const map<char, double>& bindings) const
+{
+    //the scratch buffer is kept per thread and only grows, so evaluations following the first one do not allocate
+    thread_local vector<double> slotValues{};
+
+    if(slotValues.size() < variableNames.size())
+    {
+        slotValues.resize(variableNames.size());
+    }
+
+    for(size_t slot{0}; slot < variableNames.size(); ++slot)
+    {
+        auto it = bindings.find(variableNames[slot]);
+
+        if(it == bindings.end())
+        {
+            return 0;
+        }
+
+        slotValues[slot] = it->second;
+    }
+
+    return eval(slotValues.data());
+}
+
+double CompiledExpression::eval(const double* slotValues) const
+{
+    if(!valid)
+    {
+        return 0;
+    }
+
+    //the temporaries are stored after the stack, in the same buffer
+    thread_local vector<double> stack{};
+
+    if(stack.size() < stackDepth + temporariesCount)
+    {
+        stack.resize(stackDepth + temporariesCount);
+    }
+
+    double* temporaries = stack.data() + stackDepth;
+    //index of the next free position in stack
+    size_t top{0};
+
+    for(const Instruction& instruction : program)
+    {
+        switch(instruction.type)
+        {
+            case Instruction::pushConstant:
+            {
+                stack[top++] = instruction.constant;
+                break;
+            }
+            case Instruction::pushVariable:
+            {
+                stack[top++] = slotValues[instruction.variableSlot];
+                break;
+            }
+            case Instruction::negate:
+            {
+                stack[top-1] = -stack[top-1];
+                break;
+            }
+            case Instruction::applyOperation:
+            {
+                //the rhs operand is on top of the stack and the lhs operand is beneath it, where the result is stored
+                --top;
+                stack[top-1] = Operation::apply(instruction.operationType, stack[top-1], stack[top]);
+                break;
+            }
+            case Instruction::storeTemporary:
+            {
+                temporaries[instruction.temporarySlot] = stack[top-1];
+                break;
+            }
+            case Instruction::loadTemporary:
+            {
+                stack[top++] = temporaries[instruction.temporarySlot];
+                break;
+            }
+        }
+    }
+
+    return stack[0];
+}
+
+void CompiledExpression::evalBatch(const double* const* columns, const size_t rowCount, double* results) const
+{
+    if(!valid)
+    {
+        fill_n(results, rowCount, 0.0);
+        return;
+    }
+
+    //each position of the stack, as well as each temporary, is a block of batchBlockSize values, stored contiguously
+    thread_local vector<double> stack{};
+
+    if(stack.size() < (stackDepth + temporariesCount) * batchBlockSize)
+    {
+        stack.resize((stackDepth + temporariesCount) * batchBlockSize);
+    }
+
+    double* temporaries = stack.data() + stackDepth * batchBlockSize;
+
+    for(size_t firstRow{0}; firstRow < rowCount; firstRow += batchBlockSize)
+    {
+        const size_t blockSize = min(batchBlockSize, rowCount - firstRow);
+        size_t top{0};
+
+        for(const Instruction& instruction : program)
+        {
+            switch(instruction.type)
+            {
+                case Instruction::pushConstant:
+                {
+                    fill_n(&stack[top * batchBlockSize], blockSize, instruction.constant);
+                    ++top;
+                    break;
+                }
+                case Instruction::pushVariable:
+                {
+                    copy_n(columns[instruction.variableSlot] + firstRow, blockSize, &stack[top * batchBlockSize]);
+                    ++top;
+                    break;
+                }
+                case Instruction::negate:
+                {
+                    double* values = &stack[(top-1) * batchBlockSize];
+                    for(size_t idx{0}; idx < blockSize; ++idx)
+                    {
+                        values[idx] = -values[idx];
+                    }
+                    break;
+                }
+                case Instruction::applyOperation:
+                {
+                    --top;
+                    double* lhs = &stack[(top-1) * batchBlockSize];
+                    const double* rhs = &stack[top * batchBlockSize];
+
+                    //the operation type is checked once per block, so each loop below has a branch free body
+                    switch(instruction.operationType)
+                    {
+                        case Operation::add:
+                            for(size_t idx{0}; idx < blockSize; ++idx)
+                            {
+                                lhs[idx] = lhs[idx] + rhs[idx];
+                            }
+                            break;
+                        case Operation::sub:
+                            for(size_t idx{0}; idx < blockSize; ++idx)
+                            {
+                                lhs[idx] = lhs[idx] - rhs[idx];
+                            }
+                            break;
+                        case Operation::mul:
+                            for(size_t idx{0}; idx < blockSize; ++idx)
+                            {
+                                lhs[idx] = lhs[idx] * rhs[idx];
+                            }
+                            break;
+                        case Operation::div:
+                        {
+                            /*
+                            * Same result as Operation::apply, but written with selects instead of branches, in 2 loops: the
+                            * first one divides by 1 where the divisor is close to 0, so that no lane divides by 0, and the
+                            * second one sets those lanes to the smallest double. A single loop holding both selects is not
+                            * vectorized by GCC unless -fno-trapping-math is given, whilst each of these loops is.
+                            */
+                            //the threshold of Operation::apply, whose float literal is promoted to double
+                            constexpr double minDivisorMagnitude{static_cast<double>(0.000001f)};
+
+                            for(size_t idx{0}; idx < blockSize; ++idx)
+                            {
+                                const double divisor = abs(rhs[idx]) >= minDivisorMagnitude ? rhs[idx] : 1.0;
+                                lhs[idx] = lhs[idx] / divisor;
+                            }
+                            for(size_t idx{0}; idx < blockSize; ++idx)
+                            {
+                                lhs[idx] = abs(rhs[idx]) >= minDivisorMagnitude ? lhs[idx] : numeric_limits<double>::min();
+                            }
+                            break;
+                        }
+                        default:
+                            fill_n(lhs, blockSize, 0.0);
+                            break;
+                    }
+                    break;
+                }
+                case Instruction::storeTemporary:
+                {
+                    copy_n(&stack[(top-1) * batchBlockSize], blockSize, temporaries + instruction.temporarySlot * batchBlockSize);
+                    break;
+                }
+                case Instruction::loadTemporary:
+                {
+                    copy_n(temporaries + instruction.temporarySlot * batchBlockSize, blockSize, &stack[top * batchBlockSize]);
+                    ++top;
+                    break;
+                }
+            }
+        }
+
+        copy_n(&stack[0], blockSize, results + firstRow);
+    }
+}
+
+bool CompiledExpression::evalBatch(const map<char, const double*>& columns, const size_t rowCount, double* results) const
+{
+    //resolve the columns once per batch, instead of looking up the variables once per row
+    vector<const double*> slotColumns(variableNames.size());
+
+    for(size_t slot{0}; slot < variableNames.size(); ++slot)
+    {
+        auto it = columns.find(variableNames[slot]);
+
+        if(it == columns.end())
+        {
+            fill_n(results, rowCount, 0.0);
+            return false;
+        }
+
+        slotColumns[slot] = it->second;
+    }
+
+    evalBatch(slotColumns.data(), rowCount, results);
+
+    return true;
+}
\ No newline at end of file
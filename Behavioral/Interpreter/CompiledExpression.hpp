@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include "LexingToken.hpp"
+#include "ExpressionProcessor.hpp"
+
+/*
+* 3. Compiling: ExpressionProcessor::Calculate lexes and parses the input string each time it is called,
+* which is wasteful when the same expression is evaluated many times, only with different variables values.
+* Hence, the parsing step can be performed only once, producing a program that is evaluated afterwards.
+*
+* The program is the postfix (reverse polish) form of the expression, stored as a flat vector of instructions.
+* For example: 2*(x+3) becomes: push 2, push x, push 3, add, mul. Evaluation iterates once over the
+* instructions, using a stack of doubles: values are pushed onto it, whilst operations pop their 2 operands
+* and push back the result, which is computed by the same code as Operation::eval.
+*
+* The temporaries are only used by optimized programs (see ExpressionOptimizer.hpp), so that a subexpression
+* that occurs several times is computed once, stored, then loaded wherever it is needed again.
+*/
+struct Instruction
+{
+    enum InstructionType
+    {
+        pushConstant,
+        pushVariable,
+        negate,
+        applyOperation,
+        //copies the value on top of the stack to a temporary, without popping it
+        storeTemporary,
+        //pushes the value of a temporary
+        loadTemporary
+    } type;
+
+    //only meaningful for applyOperation instructions
+    Operation::OperationType operationType{Operation::none};
+    //only meaningful for pushConstant instructions
+    double constant{};
+    //only meaningful for pushVariable instructions: index of the variable in CompiledExpression::getVariableNames()
+    size_t variableSlot{};
+    //only meaningful for storeTemporary and loadTemporary instructions
+    size_t temporarySlot{};
+};
+
+class CompiledExpression
+{
+    public:
+    CompiledExpression() = default;
+
+    /*
+    * Lexes and parses the input expression, respecting the order of operations and the parenthesis.
+    * If the expression is ill-formed (unmatched parenthesis, missing operands, compound variables names)
+    * the returned object is not valid and it always evaluates to 0.
+    */
+    static CompiledExpression compile(string_view expression);
+
+    bool isValid() const {return valid;};
+    size_t getStackDepth() const {return stackDepth;};
+    size_t getTemporariesCount() const {return temporariesCount;};
+    const vector<Instruction>& getProgram() const {return program;};
+    //the single character variables used in expression, in the order of their slots
+    const vector<char>& getVariableNames() const {return variableNames;};
+
+    /*
+    * Evaluates the program with the variables values given by the map, as ExpressionProcessor::variables.
+    * Returns 0 if a variable used in expression is not found in the map.
+    */
+    double eval(const map<char, double>& bindings) const;
+
+    /*
+    * Evaluates the program with the variables values given by slot: slotValues[idx] is the value of
+    * the variable getVariableNames()[idx]. It does not allocate, except for the first evaluation
+    * performed by a thread, when the scratch stack is sized.
+    */
+    double eval(const double* slotValues) const;
+
+    /*
+    * Batch evaluation over columnar data (struct of arrays): columns[slot] points to rowCount values of the
+    * variable getVariableNames()[slot] and results must have room for rowCount values. Instead of running the
+    * program once per row, each instruction is applied to a block of rows at a time, so that the stack holds
+    * a block of values per position. The loops over a block are simple enough to be auto-vectorized by the
+    * compiler (SSE/AVX, depending on the target architecture the code is built for, e.g. -O3 -march=native).
+    */
+    void evalBatch(const double* const* columns, const size_t rowCount, double* results) const;
+
+    /*
+    * Same as above, with the columns given by variable name. Returns false and sets all results
+    * to 0 if a variable used in expression has no column.
+    */
+    bool evalBatch(const map<char, const double*>& columns, const size_t rowCount, double* results) const;
+
+    //number of rows processed by an instruction at once, in batch evaluation
+    static constexpr size_t batchBlockSize{256};
+
+    private:
+    vector<Instruction> program;
+    vector<char> variableNames;
+    size_t stackDepth{};
+    size_t temporariesCount{};
+    bool valid{false};
+
+    //used only whilst compiling, to compute the stack depth required by the program
+    size_t currentDepth{};
+
+    void emit(const Instruction& instruction);
+    size_t getVariableSlot(const char variableName);
+    void emitOperation(const Token::Type tokenType);
+    bool compileTokens(const vector<Token>& tokens);
+    static int getPrecedence(const Token::Type tokenType);
+
+    //the optimizer rewrites the program of an already compiled expression
+    friend class ExpressionOptimizer;
+};
\ No newline at end of file
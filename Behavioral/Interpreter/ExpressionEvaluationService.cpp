@@ -0,0 +1,86 @@
+#include "ExpressionEvaluationService.hpp"
+#include "ExpressionOptimizer.hpp"
+
+#include <limits>
+
+ExpressionEvaluationService::ExpressionEvaluationService(const size_t capacity, const size_t shardsCount)
+{
+    const size_t actualShardsCount = max<size_t>(1, shardsCount);
+
+    //round up, so the shards can hold at least capacity expressions together, with at least one per shard
+    shardCapacity = max<size_t>(1, (capacity + actualShardsCount - 1) / actualShardsCount);
+
+    for(size_t idx{0}; idx < actualShardsCount; ++idx)
+    {
+        shards.push_back(make_unique<Shard>());
+    }
+}
+
+ExpressionEvaluationService::Shard& ExpressionEvaluationService::getShard(const size_t expressionHash)
+{
+    //the high bits, so that the expressions of a shard do not share the low bits used by the buckets of its index
+    return *shards[(expressionHash >> (numeric_limits<size_t>::digits / 2)) % shards.size()];
+}
+
+shared_ptr<const CompiledExpression> ExpressionEvaluationService::getCompiled(string_view expression)
+{
+    const IndexKey key{expression, hash<string_view>{}(expression)};
+    Shard& shard = getShard(key.textHash);
+
+    {
+        lock_guard<mutex> lock{shard.shardMutex};
+
+        auto it = shard.index.find(key);
+        if(it != shard.index.end())
+        {
+            //mark the expression as the most recently used one, by moving its node to the front of the list
+            shard.lruList.splice(shard.lruList.begin(), shard.lruList, it->second);
+
+            return it->second->compiled;
+        }
+    }
+
+    //compile without holding the lock, so other threads can use the shard meanwhile
+    auto compiled = make_shared<const CompiledExpression>(ExpressionOptimizer::optimize(CompiledExpression::compile(expression)));
+
+    lock_guard<mutex> lock{shard.shardMutex};
+
+    //another thread might have compiled and cached the same expression meanwhile, so use that one
+    auto it = shard.index.find(key);
+    if(it != shard.index.end())
+    {
+        shard.lruList.splice(shard.lruList.begin(), shard.lruList, it->second);
+
+        return it->second->compiled;
+    }
+
+    shard.lruList.push_front(CachedExpression{string{expression}, key.textHash, compiled});
+    shard.index.emplace(IndexKey{shard.lruList.front().text, key.textHash}, shard.lruList.begin());
+
+    //drop the least recently used expression, at the back of the list, if the shard is over capacity
+    if(shard.lruList.size() > shardCapacity)
+    {
+        shard.index.erase(IndexKey{shard.lruList.back().text, shard.lruList.back().textHash});
+        shard.lruList.pop_back();
+    }
+
+    return compiled;
+}
+
+double ExpressionEvaluationService::evaluate(string_view expression, const BindingContext& context)
+{
+    return getCompiled(expression)->eval(context.variables);
+}
+
+size_t ExpressionEvaluationService::size() const
+{
+    size_t result{0};
+
+    for(const unique_ptr<Shard>& shard : shards)
+    {
+        lock_guard<mutex> lock{shard->shardMutex};
+        result += shard->lruList.size();
+    }
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "CompiledExpression.hpp"
+
+/*
+* 4. Sharing expressions between threads: ExpressionProcessor keeps the variables values as a public member, which is
+* modified by each user, so one instance cannot be used by several threads at once. On the other hand, a CompiledExpression
+* is not modified by evaluation, thus it can be shared freely once it has been created.
+*
+* The variables values are therefore kept apart, in a BindingContext. Each thread has its own context, so no locking is
+* required to set variables or to evaluate an expression.
+*/
+struct BindingContext
+{
+    map<char, double> variables;
+};
+
+/*
+* The service keeps the expressions it has compiled in a cache, keyed by the expression's text, so an expression is lexed and
+* parsed only the first time it is requested. The cache has a limited capacity: when it is full, the least recently used
+* expression is dropped (LRU). The compiled expressions are handed out as shared_ptr, so one that is being evaluated by
+* a thread stays alive even if, in the meantime, it is dropped from the cache by another thread.
+*
+* The cache is split in shards, based on the hash of the text, each shard having its own mutex, list and index. Thus, threads
+* looking up different expressions rarely wait for each other, and the mutex is held only for a hash lookup and a list splice.
+* Compiling and optimizing a missing expression is done outside the lock. The text is hashed once per lookup: the shard is
+* chosen from the high bits of the hash, whilst the shard's index reuses the whole hash, which its buckets take the low bits of.
+* The text is taken as string_view, so looking up a literal or a part of a bigger buffer does not allocate.
+*/
+class ExpressionEvaluationService
+{
+    public:
+    explicit ExpressionEvaluationService(const size_t capacity, const size_t shardsCount = 8);
+
+    ExpressionEvaluationService(const ExpressionEvaluationService&) = delete;
+    ExpressionEvaluationService& operator=(const ExpressionEvaluationService&) = delete;
+
+    //returns the compiled expression from cache, compiling and caching it if it is not found
+    shared_ptr<const CompiledExpression> getCompiled(string_view expression);
+
+    double evaluate(string_view expression, const BindingContext& context);
+
+    //evaluates using the binding context of the calling thread
+    double evaluate(string_view expression)
+    {
+        return evaluate(expression, getThreadContext());
+    }
+
+    //each thread gets its own context, created on the first call performed by that thread
+    static BindingContext& getThreadContext()
+    {
+        thread_local BindingContext context{};
+
+        return context;
+    }
+
+    //number of expressions currently cached
+    size_t size() const;
+
+    private:
+    struct CachedExpression
+    {
+        string text;
+        //kept to remove the expression from the index, without hashing the text again
+        size_t textHash;
+        shared_ptr<const CompiledExpression> compiled;
+    };
+
+    //the most recently used expression is at the front of the list
+    using LruList = list<CachedExpression>;
+
+    //the text is a view of the string owned by a list node, which does not move, or of the text being looked up
+    struct IndexKey
+    {
+        string_view text;
+        size_t textHash;
+
+        bool operator==(const IndexKey& other) const {return text == other.text;};
+    };
+
+    //the hash is computed once per lookup, before the shard is chosen, so the index only returns it
+    struct IndexKeyHash
+    {
+        size_t operator()(const IndexKey& key) const {return key.textHash;};
+    };
+
+    struct Shard
+    {
+        mutable mutex shardMutex;
+        LruList lruList;
+        unordered_map<IndexKey, LruList::iterator, IndexKeyHash> index;
+    };
+
+    size_t shardCapacity;
+    vector<unique_ptr<Shard>> shards;
+
+    Shard& getShard(const size_t expressionHash);
+};
\ No newline at end of file
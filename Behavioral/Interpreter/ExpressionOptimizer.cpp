@@ -0,0 +1,265 @@
+#include "ExpressionOptimizer.hpp"
+
+#include <cstring>
+
+size_t ExpressionOptimizer::addNode(const DagNode& node)
+{
+    uint64_t constantBits{};
+    memcpy(&constantBits, &node.constant, sizeof(constantBits));
+
+    NodeKey key{node.type, node.operationType, constantBits, node.variableSlot, node.lhs, node.rhs};
+
+    //reuse the identical node, if it was already created
+    auto it = nodesIndex.find(key);
+    if(it != nodesIndex.end())
+    {
+        return it->second;
+    }
+
+    nodes.push_back(node);
+    nodesIndex.emplace(key, nodes.size() - 1);
+
+    return nodes.size() - 1;
+}
+
+size_t ExpressionOptimizer::addConstant(const double value)
+{
+    DagNode node{Instruction::pushConstant};
+    node.constant = value;
+
+    return addNode(node);
+}
+
+bool ExpressionOptimizer::isConstant(const size_t nodeIdx, const double value) const
+{
+    return nodes[nodeIdx].type == Instruction::pushConstant && nodes[nodeIdx].constant == value;
+}
+
+size_t ExpressionOptimizer::addNegation(const size_t operand)
+{
+    if(nodes[operand].type == Instruction::pushConstant)
+    {
+        return addConstant(-nodes[operand].constant);
+    }
+
+    //--x is x
+    if(nodes[operand].type == Instruction::negate)
+    {
+        return nodes[operand].lhs;
+    }
+
+    DagNode node{Instruction::negate};
+    node.lhs = operand;
+
+    return addNode(node);
+}
+
+size_t ExpressionOptimizer::addOperation(const Operation::OperationType operationType, const size_t lhs, const size_t rhs)
+{
+    if(nodes[lhs].type == Instruction::pushConstant && nodes[rhs].type == Instruction::pushConstant)
+    {
+        return addConstant(Operation::apply(operationType, nodes[lhs].constant, nodes[rhs].constant));
+    }
+
+    switch(operationType)
+    {
+        case Operation::add:
+            if(isConstant(rhs, 0.0))
+            {
+                return lhs;
+            }
+            if(isConstant(lhs, 0.0))
+            {
+                return rhs;
+            }
+            break;
+        case Operation::sub:
+        case Operation::div:
+            if(isConstant(rhs, operationType == Operation::sub ? 0.0 : 1.0))
+            {
+                return lhs;
+            }
+            break;
+        case Operation::mul:
+            if(isConstant(rhs, 1.0))
+            {
+                return lhs;
+            }
+            if(isConstant(lhs, 1.0))
+            {
+                return rhs;
+            }
+            break;
+        default:
+            break;
+    }
+
+    DagNode node{Instruction::applyOperation};
+    node.operationType = operationType;
+    node.lhs = lhs;
+    node.rhs = rhs;
+
+    return addNode(node);
+}
+
+/*
+* Each node is counted once per user. The operands of a node are visited only on its first use, as the following
+* uses load the node from a temporary, without computing its operands again. The walk uses an explicit stack, instead
+* of recursion, as a long flat formula, such as x+1+1+...+1, makes a DAG as deep as the number of its terms.
+*/
+void ExpressionOptimizer::countUses(const size_t nodeIdx)
+{
+    vector<size_t> pendingNodes{nodeIdx};
+
+    while(!pendingNodes.empty())
+    {
+        DagNode& node = nodes[pendingNodes.back()];
+        pendingNodes.pop_back();
+
+        if(node.usesCount++ > 0)
+        {
+            continue;
+        }
+
+        if(node.type == Instruction::negate)
+        {
+            pendingNodes.push_back(node.lhs);
+        }
+        else if(node.type == Instruction::applyOperation)
+        {
+            pendingNodes.push_back(node.lhs);
+            pendingNodes.push_back(node.rhs);
+        }
+    }
+}
+
+/*
+* Emits the nodes in postorder, as the recursive evaluation of the tree would: the operands of a node, lhs first, then the node.
+* The explicit stack holds the nodes whose operands are being emitted, each node being pushed a second time, as expanded, once its
+* operands are pushed, above it: lhs is pushed last, so it is emitted first, including all its operands, before rhs is looked at.
+*/
+void ExpressionOptimizer::emitNode(const size_t nodeIdx, CompiledExpression& result)
+{
+    struct PendingNode
+    {
+        size_t nodeIdx;
+        bool isExpanded;
+    };
+
+    vector<PendingNode> pendingNodes{PendingNode{nodeIdx, false}};
+
+    while(!pendingNodes.empty())
+    {
+        const PendingNode pending = pendingNodes.back();
+        pendingNodes.pop_back();
+        DagNode& node = nodes[pending.nodeIdx];
+
+        if(node.isStored)
+        {
+            Instruction load{Instruction::loadTemporary};
+            load.temporarySlot = node.temporarySlot;
+            result.emit(load);
+            continue;
+        }
+
+        if(!pending.isExpanded && (node.type == Instruction::negate || node.type == Instruction::applyOperation))
+        {
+            pendingNodes.push_back(PendingNode{pending.nodeIdx, true});
+
+            if(node.type == Instruction::applyOperation)
+            {
+                pendingNodes.push_back(PendingNode{node.rhs, false});
+            }
+            pendingNodes.push_back(PendingNode{node.lhs, false});
+            continue;
+        }
+
+        Instruction instruction{node.type};
+
+        switch(node.type)
+        {
+            case Instruction::pushConstant:
+                instruction.constant = node.constant;
+                break;
+            case Instruction::pushVariable:
+                instruction.variableSlot = node.variableSlot;
+                break;
+            case Instruction::applyOperation:
+                instruction.operationType = node.operationType;
+                break;
+            default:
+                break;
+        }
+
+        result.emit(instruction);
+
+        //values and constants are cheap to push again, so only computed nodes used several times are stored
+        if(node.usesCount > 1 && (node.type == Instruction::negate || node.type == Instruction::applyOperation))
+        {
+            node.isStored = true;
+            node.temporarySlot = result.temporariesCount++;
+
+            Instruction store{Instruction::storeTemporary};
+            store.temporarySlot = node.temporarySlot;
+            result.emit(store);
+        }
+    }
+}
+
+CompiledExpression ExpressionOptimizer::optimize(const CompiledExpression& compiled)
+{
+    if(!compiled.isValid())
+    {
+        return compiled;
+    }
+
+    ExpressionOptimizer optimizer{};
+    vector<size_t> nodesStack{};
+
+    //evaluate the program symbolically: the stack holds the nodes computing the values, instead of the values
+    for(const Instruction& instruction : compiled.getProgram())
+    {
+        switch(instruction.type)
+        {
+            case Instruction::pushConstant:
+            {
+                nodesStack.push_back(optimizer.addConstant(instruction.constant));
+                break;
+            }
+            case Instruction::pushVariable:
+            {
+                DagNode node{Instruction::pushVariable};
+                node.variableSlot = instruction.variableSlot;
+                nodesStack.push_back(optimizer.addNode(node));
+                break;
+            }
+            case Instruction::negate:
+            {
+                nodesStack.back() = optimizer.addNegation(nodesStack.back());
+                break;
+            }
+            case Instruction::applyOperation:
+            {
+                size_t rhs = nodesStack.back();
+                nodesStack.pop_back();
+                nodesStack.back() = optimizer.addOperation(instruction.operationType, nodesStack.back(), rhs);
+                break;
+            }
+            //the input program is already optimized, so there is nothing to gain from optimizing it again
+            default:
+            {
+                return compiled;
+            }
+        }
+    }
+
+    //the variables slots are kept as they were, so the columns and values given to eval stay the same
+    CompiledExpression result{};
+    result.variableNames = compiled.variableNames;
+    result.valid = true;
+
+    optimizer.countUses(nodesStack.back());
+    optimizer.emitNode(nodesStack.back(), result);
+
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "CompiledExpression.hpp"
+
+/*
+* 5. Optimizing: the program of a compiled expression is evaluated as it was written, so the parts of expression that do not
+* depend on variables are computed again at each evaluation, same as the subexpressions that are written several times.
+*
+* The optimizer rebuilds the expression tree out of the postfix program, by simulating its evaluation with a stack of tree nodes
+* instead of values. Whilst doing so, it performs the following rewrites:
+*   - constant folding: an operation, or a negation, whose operands are all constants is replaced by a constant holding its result,
+*     computed with Operation::apply, so the result is the same as the one computed at evaluation time
+*   - identities: x+0, 0+x, x-0, x*1, 1*x, x/1 are replaced by x and --x is replaced by x
+*   - common subexpressions: the nodes are hash-consed, i.e. a node identical to an existing one (same kind, same operation and same
+*     operands) is not created again, but the existing one is reused. Hence the tree becomes a directed acyclic graph (DAG).
+* The operations are neither reordered nor regrouped, so x*2*3 stays (x*2)*3, as floating point operations are not associative.
+*
+* Afterwards, a new program is emitted from the DAG. A node used more than once is computed only the first time it is met,
+* then its value is kept in a temporary that is loaded for each subsequent use.
+*/
+class ExpressionOptimizer
+{
+    public:
+    static CompiledExpression optimize(const CompiledExpression& compiled);
+
+    private:
+    struct DagNode
+    {
+        Instruction::InstructionType type;
+        Operation::OperationType operationType{Operation::none};
+        double constant{};
+        size_t variableSlot{};
+        //indeces of the operands in the nodes list: lhs is the only operand of negation
+        size_t lhs{}, rhs{};
+        //number of nodes, or of programs' results, using this node as operand
+        size_t usesCount{};
+        //set once the node has been emitted and stored in a temporary
+        bool isStored{false};
+        size_t temporarySlot{};
+    };
+
+    //the identity of a node: type, operation, bits of the constant, variable slot, lhs and rhs
+    using NodeKey = tuple<int, int, uint64_t, size_t, size_t, size_t>;
+
+    vector<DagNode> nodes;
+    map<NodeKey, size_t> nodesIndex;
+
+    size_t addNode(const DagNode& node);
+    size_t addConstant(const double value);
+    size_t addNegation(const size_t operand);
+    size_t addOperation(const Operation::OperationType operationType, const size_t lhs, const size_t rhs);
+    bool isConstant(const size_t nodeIdx, const double value) const;
+    void countUses(const size_t nodeIdx);
+    void emitNode(const size_t nodeIdx, CompiledExpression& result);
+};
\ No newline at end of file
@@ -374,10 +374,13 @@ double ExpressionProcessor::Calculate(const string& expression)
     LexingProcessor lexProc{};
     vector<Token> tokens = lexProc.lexingInputText(expression);
 
-    cout<<"After lexing:"<<endl;
-    for(auto& token : tokens)
+    if(verbose)
     {
-        cout << token;
+        cout<<"After lexing:"<<endl;
+        for(auto& token : tokens)
+        {
+            cout << token;
+        }
     }
 
     if(tokens.size() == 1)
@@ -415,10 +418,13 @@ double ExpressionProcessor::Calculate(const string& expression)
             tokens = move(intermediateParsedTokens);
         }
         
-        cout<<endl<<" After computing parenthesis"<<endl;
-        for(auto& token : tokens)
+        if(verbose)
         {
-            cout << token;
+            cout<<endl<<" After computing parenthesis"<<endl;
+            for(auto& token : tokens)
+            {
+                cout << token;
+            }
         }
 
         /*
@@ -433,13 +439,16 @@ double ExpressionProcessor::Calculate(const string& expression)
             tokens = move(intermediateParsedTokens);
         }
 
-        cout<<endl<<" After computing mul and div operations:"<<endl;
-        for(auto& token : tokens)
+        if(verbose)
         {
-            cout << token;
-        }
+            cout<<endl<<" After computing mul and div operations:"<<endl;
+            for(auto& token : tokens)
+            {
+                cout << token;
+            }
 
-        cout<<endl;
+            cout<<endl;
+        }
 
         result = computeAdditionsAndSubstractions(tokens);
     }
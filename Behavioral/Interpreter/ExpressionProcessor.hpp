@@ -65,26 +65,36 @@ struct Operation: public Element
     Operation():operationType{none}{};
     
     double eval() const override
+    {
+        return apply(operationType, lhs.eval(), rhs.eval());
+    }
+
+    /*
+    * The arithmetic behind eval(), exposed as a static method so that it can be reused by the compiled
+    * form of an expression (see CompiledExpression.hpp), which works on plain doubles instead of operands.
+    * Dividing by a value close to 0 yields the smallest double, same as an unresolved operand does.
+    */
+    static double apply(const OperationType type, const double lhsValue, const double rhsValue)
     {
         double result{};
 
-        if(operationType == add)
+        if(type == add)
         {
-            result = lhs.eval() + rhs.eval();
+            result = lhsValue + rhsValue;
         }
-        if(operationType == sub)
+        if(type == sub)
         {
-            result = lhs.eval() - rhs.eval();
+            result = lhsValue - rhsValue;
         }
-        if(operationType == mul)
+        if(type == mul)
         {
-            result = lhs.eval() * rhs.eval();
+            result = lhsValue * rhsValue;
         }
-        if(operationType == div)
+        if(type == div)
         {
-            if(abs(rhs.eval() - 0.0f) >= 0.000001f)
+            if(abs(rhsValue - 0.0f) >= 0.000001f)
             {
-                result = lhs.eval() / rhs.eval();
+                result = lhsValue / rhsValue;
             }
             else
             {
@@ -107,5 +117,7 @@ class ExpressionProcessor
 
     public:
     map<char, double> variables;                         
+    //print the tokens after each computational step
+    bool verbose{true};
     double Calculate(const string& expression);
 };
\ No newline at end of file
@@ -16,7 +16,7 @@ bool LexingProcessor::isDigitOrIsAlpha(const char inputCharFromText, const Token
     return result;
 }
 
-void LexingProcessor::processNumbersAndVariables(const string& inputText, size_t& idx, const Token::Type tokenType, vector<Token>& result)
+void LexingProcessor::processNumbersAndVariables(string_view inputText, size_t& idx, const Token::Type tokenType, vector<Token>& result)
 {
     // in case a number/char is encountered, add it to a stringstream, then check if it is followed by characters of the same type 
     // (i.e if it is > 9, for numbers, or if it as a compound variable name like xyz)
@@ -27,7 +27,7 @@ void LexingProcessor::processNumbersAndVariables(const string& inputText, size_t
     bool isFloatingPoint{false};
     
     // search if the found integer/char is followed by characters of the same kind
-    for(string::size_type idy = idx+1; idy < inputText.size(); ++idy)
+    for(string_view::size_type idy = idx+1; idy < inputText.size(); ++idy)
     {
         // if further caharcters with same tokenType are encountered, add them to stringstream buffer, to construct the number/variable
         if(isDigitOrIsAlpha(inputText[idy], tokenType))
@@ -62,12 +62,12 @@ void LexingProcessor::processNumbersAndVariables(const string& inputText, size_t
     }
 }
 
-vector<Token> LexingProcessor::lexingInputText(const string& inputText)
+vector<Token> LexingProcessor::lexingInputText(string_view inputText)
 {
     vector<Token> result;
 
     //iterate over the input text character by character and check it against possible token types
-    for(string::size_type idx{0}, length = inputText.size(); idx < length; ++idx)
+    for(string_view::size_type idx{0}, length = inputText.size(); idx < length; ++idx)
     {
         switch(inputText[idx])
         {
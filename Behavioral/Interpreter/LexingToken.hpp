@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 
@@ -54,8 +55,9 @@ struct LexingProcessor
     * 1.2 The second and last part of lexing uses the Token struct definition to split the
     * inout string into multiple tokens. Hence the out put is a vector of tokens.
     * The choice here is to encapsulate this business logic into a method of the given struct.
+    * The input is taken as string_view, so that expressions which are part of a bigger buffer can be lexed without copying them.
     */
-    vector<Token> lexingInputText(const string& inputText);
+    vector<Token> lexingInputText(string_view inputText);
 
     private:
     /*
@@ -67,6 +69,6 @@ struct LexingProcessor
     * Such entities need separate lexing as it is more complex because they might be compound, such as: 396.89 or xyzt, so
     * they require buffering of each next character of similar type 
     */
-    void processNumbersAndVariables(const string& inputText, size_t& idx, const Token::Type tokenType, vector<Token>& result);
+    void processNumbersAndVariables(string_view inputText, size_t& idx, const Token::Type tokenType, vector<Token>& result);
 };
 
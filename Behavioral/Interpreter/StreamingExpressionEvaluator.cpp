@@ -0,0 +1,256 @@
+#include "StreamingExpressionEvaluator.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+* Maps a file in memory for reading, using the POSIX API. The mapping is released by the destructor.
+* If the file cannot be mapped (e.g. it is empty or it is not a regular file), its content is read into a buffer instead.
+*/
+class MappedFile
+{
+    public:
+    explicit MappedFile(const string& path)
+    {
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        struct stat fileStatus{};
+
+        if(fileDescriptor >= 0 && fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+            if(mapping != MAP_FAILED)
+            {
+                //the file is read from start to end, so the kernel can read ahead aggressively
+                madvise(mapping, fileStatus.st_size, MADV_SEQUENTIAL);
+                mMapping = mapping;
+                mContent = string_view{static_cast<const char*>(mapping), static_cast<size_t>(fileStatus.st_size)};
+                isOpen = true;
+            }
+        }
+
+        if(fileDescriptor >= 0)
+        {
+            close(fileDescriptor);
+        }
+
+        if(!isOpen)
+        {
+            ifstream inputFile{path, ios::binary};
+
+            if(inputFile)
+            {
+                mFallbackBuffer.assign(istreambuf_iterator<char>{inputFile}, istreambuf_iterator<char>{});
+                mContent = string_view{mFallbackBuffer};
+                isOpen = true;
+            }
+        }
+    }
+
+    ~MappedFile()
+    {
+        if(mMapping)
+        {
+            munmap(mMapping, mContent.size());
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen{false};
+    string_view getContent() const {return mContent;};
+
+    private:
+    void* mMapping{nullptr};
+    string_view mContent;
+    string mFallbackBuffer;
+};
+
+StreamingExpressionEvaluator::StreamingExpressionEvaluator(const size_t threadsCount, const size_t chunkSize) : threadsCount{max<size_t>(1, threadsCount)},
+                                                                                                                 chunkSize{max<size_t>(1, chunkSize)}
+{}
+
+bool StreamingExpressionEvaluator::evaluateFile(const string& inputPath, ostream& output) const
+{
+    MappedFile inputFile{inputPath};
+
+    if(!inputFile.isOpen)
+    {
+        return false;
+    }
+
+    evaluateBuffer(inputFile.getContent(), output);
+
+    return true;
+}
+
+//each chunk ends right after a new line character, except the last one, which ends with the input
+vector<string_view> StreamingExpressionEvaluator::splitInChunks(string_view input) const
+{
+    vector<string_view> result{};
+    size_t chunkStart{0};
+
+    while(chunkStart < input.size())
+    {
+        size_t chunkEnd = input.find('\n', min(chunkStart + chunkSize, input.size()) - 1);
+        chunkEnd = (chunkEnd == string_view::npos) ? input.size() : chunkEnd + 1;
+
+        result.push_back(input.substr(chunkStart, chunkEnd - chunkStart));
+        chunkStart = chunkEnd;
+    }
+
+    return result;
+}
+
+/*
+* The bindings are parsed into a table indexed by the variables' names. Then the values of the variables
+* used by the expression are copied, in the order of their slots, to the values given to eval.
+*/
+double StreamingExpressionEvaluator::evaluateWithBindings(const CompiledExpression& compiled, string_view bindings)
+{
+    double values[256]{};
+    bool isBound[256]{};
+
+    //bindings are formed as: name=value,name=value, with optional spaces around names
+    while(!bindings.empty())
+    {
+        size_t bindingEnd = bindings.find(',');
+        string_view binding = bindings.substr(0, bindingEnd);
+        bindings = (bindingEnd == string_view::npos) ? string_view{} : bindings.substr(bindingEnd + 1);
+
+        size_t equalIdx = binding.find('=');
+        if(equalIdx == string_view::npos)
+        {
+            continue;
+        }
+
+        string_view name = binding.substr(0, equalIdx);
+        string_view value = binding.substr(equalIdx + 1);
+
+        while(!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while(!name.empty() && name.back() == ' ') name.remove_suffix(1);
+        while(!value.empty() && value.front() == ' ') value.remove_prefix(1);
+
+        double parsedValue{};
+        if(name.size() == 1 && from_chars(value.data(), value.data() + value.size(), parsedValue).ec == errc{})
+        {
+            values[static_cast<unsigned char>(name[0])] = parsedValue;
+            isBound[static_cast<unsigned char>(name[0])] = true;
+        }
+    }
+
+    const vector<char>& variableNames = compiled.getVariableNames();
+    double slotValues[256]{};
+
+    for(size_t slot{0}; slot < variableNames.size(); ++slot)
+    {
+        unsigned char name = static_cast<unsigned char>(variableNames[slot]);
+
+        if(!isBound[name])
+        {
+            return 0;
+        }
+
+        slotValues[slot] = values[name];
+    }
+
+    return compiled.eval(slotValues);
+}
+
+void StreamingExpressionEvaluator::evaluateChunk(string_view chunk, vector<double>& results)
+{
+    //the keys are views into the input buffer, which outlives the chunk's processing
+    unordered_map<string_view, CompiledExpression> compiledExpressions{};
+
+    while(!chunk.empty())
+    {
+        size_t lineEnd = chunk.find('\n');
+        string_view line = chunk.substr(0, lineEnd);
+        chunk = (lineEnd == string_view::npos) ? string_view{} : chunk.substr(lineEnd + 1);
+
+        //tolerate windows line endings
+        if(!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        //a blank line has a result as well, so the results stay aligned with the input lines
+        if(line.empty())
+        {
+            results.push_back(0);
+            continue;
+        }
+
+        size_t separatorIdx = line.find(';');
+        string_view expression = line.substr(0, separatorIdx);
+        string_view bindings = (separatorIdx == string_view::npos) ? string_view{} : line.substr(separatorIdx + 1);
+
+        /*
+        * The conversions of numbers report ill-formed or out of range values by throwing logic_error (invalid_argument or
+        * out_of_range), which must not escape the worker thread, as it would terminate the process. Such a line is ill-formed.
+        */
+        try
+        {
+            auto it = compiledExpressions.find(expression);
+
+            if(it == compiledExpressions.end())
+            {
+                it = compiledExpressions.emplace(expression, CompiledExpression::compile(expression)).first;
+            }
+
+            results.push_back(evaluateWithBindings(it->second, bindings));
+        }
+        catch(const logic_error&)
+        {
+            results.push_back(0);
+        }
+    }
+}
+
+void StreamingExpressionEvaluator::evaluateBuffer(string_view input, ostream& output) const
+{
+    vector<string_view> chunks = splitInChunks(input);
+    vector<vector<double>> chunksResults(chunks.size());
+    atomic<size_t> nextChunkIdx{0};
+
+    auto processChunks = [&chunks, &chunksResults, &nextChunkIdx]()
+    {
+        for(size_t chunkIdx = nextChunkIdx++; chunkIdx < chunks.size(); chunkIdx = nextChunkIdx++)
+        {
+            evaluateChunk(chunks[chunkIdx], chunksResults[chunkIdx]);
+        }
+    };
+
+    vector<thread> workers{};
+    for(size_t idx{1}; idx < min(threadsCount, chunks.size()); ++idx)
+    {
+        workers.emplace_back(processChunks);
+    }
+
+    //the calling thread processes chunks as well
+    processChunks();
+
+    for(thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    //the chunks are written in their input order, regardless of the order they were processed in
+    for(const vector<double>& chunkResults : chunksResults)
+    {
+        for(double result : chunkResults)
+        {
+            output << result << '\n';
+        }
+    }
+}
\ No newline at end of file
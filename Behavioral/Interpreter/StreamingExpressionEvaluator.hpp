@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "CompiledExpression.hpp"
+
+/*
+* 7. Streaming evaluation: computes large inputs made of lines such as:
+*       x*2+y/(z-1);x=3,y=4.5,z=2
+* that is, an expression followed by the values of its variables, separated by ';'. The result of each line is written
+* to the output, on its own line, in the order of the input lines. A line whose expression is ill-formed, or which lacks
+* the value of a variable used by its expression, has the result 0, same as CompiledExpression::eval. So does a blank line,
+* thus the i-th result is always the one of the i-th input line.
+*
+* The input file is memory mapped, so it is not copied into the process' memory, and the lines are processed in place,
+* as string_views into the mapped buffer: neither the lines, nor the expressions are copied to strings. The buffer is
+* split in chunks ending at line boundaries, which are processed in parallel: each thread takes the next unprocessed chunk,
+* evaluates its lines and keeps the results of the chunk. In the end, the results are written chunk by chunk, in order.
+* Each chunk keeps the expressions it has compiled, so an expression repeated on several lines is compiled once per chunk.
+*/
+class StreamingExpressionEvaluator
+{
+    public:
+    explicit StreamingExpressionEvaluator(const size_t threadsCount = thread::hardware_concurrency(),
+                                          const size_t chunkSize = 1 << 20);
+
+    //returns false if the input file cannot be opened or read
+    bool evaluateFile(const string& inputPath, ostream& output) const;
+
+    void evaluateBuffer(string_view input, ostream& output) const;
+
+    private:
+    size_t threadsCount;
+    //approximate size in bytes of the chunks the input is split in
+    size_t chunkSize;
+
+    vector<string_view> splitInChunks(string_view input) const;
+    static void evaluateChunk(string_view chunk, vector<double>& results);
+    static double evaluateWithBindings(const CompiledExpression& compiled, string_view bindings);
+};
\ No newline at end of file
@@ -1,4 +1,11 @@
 #include "ExpressionProcessor.hpp"
+#include "CompiledExpression.hpp"
+#include "ExpressionEvaluationService.hpp"
+#include "ExpressionOptimizer.hpp"
+#include "ClosureExpression.hpp"
+#include "StreamingExpressionEvaluator.hpp"
+
+#include <thread>
 
 /*
 * Interpreter is a design pattern that deals with text interpretation. Mainly, it comprises of 2 steps
@@ -66,5 +73,106 @@ int main()
     result = ep.Calculate("2+((5+3*2-1)-(5*1-2.5)*2)");
     cout<<endl<<"result = "<<result<<endl;
 
+    //parse the expression only once, then evaluate it for different values of the variables
+    CompiledExpression compiled = CompiledExpression::compile("2*(x+4/2)/(y-3.0)+4*(7.5-z)");
+    cout<<endl<<"compiled expression is valid: "<<compiled.isValid()<<", instructions: "<<compiled.getProgram().size()<<endl;
+    for(double x : {1.0, 2.0, 3.0})
+    {
+        ep.variables['x'] = x;
+        ep.variables['y'] = 4.5;
+        ep.variables['z'] = 5;
+        cout<<"x = "<<x<<" result = "<<compiled.eval(ep.variables)<<endl;
+    }
+
+    result = CompiledExpression::compile("-(2+y)*-x").eval(ep.variables);
+    cout<<endl<<"result = "<<result<<endl;
+
+    result = CompiledExpression::compile("(2+3").eval(ep.variables);
+    cout<<endl<<"result of ill-formed expression = "<<result<<endl;
+
+    //the parser does not recurse, so deeply nested expressions do not overflow the call stack
+    string nestedFormula = string(100000, '(') + "x" + string(100000, ')');
+    cout<<"result of 100000 nested parenthesis = "<<CompiledExpression::compile(nestedFormula).eval(ep.variables)<<endl;
+
+    //evaluate the same expression over many rows at once, with one array of values per variable
+    vector<double> xColumn{}, yColumn{}, batchResults(1000);
+    for(size_t row{0}; row < batchResults.size(); ++row)
+    {
+        xColumn.push_back(row * 0.5);
+        yColumn.push_back(row % 7);
+    }
+
+    CompiledExpression batchCompiled = CompiledExpression::compile("x*x/y-(x+2)*3");
+    batchCompiled.evalBatch({{'x', xColumn.data()}, {'y', yColumn.data()}}, batchResults.size(), batchResults.data());
+
+    double rowValues[2]{};
+    for(size_t row : {1, 7, 500, 999})
+    {
+        //the slots follow the order of the variables in expression: x, then y
+        rowValues[0] = xColumn[row];
+        rowValues[1] = yColumn[row];
+        cout<<"row "<<row<<": batch result = "<<batchResults[row]<<", single result = "<<batchCompiled.eval(rowValues)<<endl;
+    }
+
+    //constant parts are computed once, when optimizing, whilst (x+y) is computed once per evaluation and reused
+    CompiledExpression unoptimized = CompiledExpression::compile("2*3.5/7+1-4*(x+y)*1+(x+y)/(0+z)");
+    CompiledExpression optimized = ExpressionOptimizer::optimize(unoptimized);
+    cout<<endl<<"instructions before optimizing: "<<unoptimized.getProgram().size()<<", after: "<<optimized.getProgram().size()<<endl;
+    cout<<"unoptimized result = "<<unoptimized.eval(ep.variables)<<", optimized result = "<<optimized.eval(ep.variables)<<endl;
+
+    //the same expression evaluated by calling closures instead of interpreting instructions
+    ClosureExpression closure{optimized};
+    cout<<"closure result = "<<closure.eval(ep.variables)<<endl;
+
+    //a long flat formula makes a DAG as deep as its number of terms, which the optimizer walks without recursion
+    string flatFormula{"x"};
+    for(size_t termIdx{0}; termIdx < 200000; ++termIdx)
+    {
+        flatFormula += "+1";
+    }
+    CompiledExpression flatOptimized = ExpressionOptimizer::optimize(CompiledExpression::compile(flatFormula));
+    cout<<"flat formula of "<<flatOptimized.getProgram().size()<<" instructions, result = "<<flatOptimized.eval(ep.variables)<<endl;
+    //its tree is too deep for the closures, which would call each other recursively, so it is evaluated by the instructions' loop
+    ClosureExpression flatClosure{flatOptimized};
+    cout<<"flat formula evaluated by closures: "<<flatClosure.usesClosures()<<", result = "<<flatClosure.eval(ep.variables)<<endl;
+
+    //several threads evaluate the same expressions, each one with its own variables values
+    ExpressionEvaluationService service{16};
+    vector<thread> workers{};
+    vector<double> workersResults(4);
+    for(size_t workerIdx{0}; workerIdx < workersResults.size(); ++workerIdx)
+    {
+        workers.emplace_back([&service, &workersResults, workerIdx]()
+        {
+            BindingContext& context = ExpressionEvaluationService::getThreadContext();
+            context.variables['x'] = workerIdx;
+
+            for(size_t idx{0}; idx < 1000; ++idx)
+            {
+                context.variables['y'] = idx;
+                workersResults[workerIdx] += service.evaluate("x*10+y/1000") + service.evaluate("(x-1)*(x+1)");
+            }
+        });
+    }
+
+    for(thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    cout<<"cached expressions: "<<service.size()<<endl;
+    for(size_t workerIdx{0}; workerIdx < workersResults.size(); ++workerIdx)
+    {
+        cout<<"worker "<<workerIdx<<" result = "<<workersResults[workerIdx]<<endl;
+    }
+
+    //evaluate a file whose lines are formed as: expression;variable=value,variable=value
+    cout<<endl<<"results of expressions.txt:"<<endl;
+    StreamingExpressionEvaluator streamingEvaluator{};
+    if(!streamingEvaluator.evaluateFile("expressions.txt", cout))
+    {
+        cout<<"expressions.txt could not be read"<<endl;
+    }
+
     return 0;
 }
\ No newline at end of file
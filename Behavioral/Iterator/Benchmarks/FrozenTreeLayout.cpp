@@ -0,0 +1,141 @@
+#include "../NodeTraversals.hpp"
+#include "../NodeIterators.hpp"
+#include "../FrozenTree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <random>
+
+/*
+* Benchmark of a binary search tree made of Node<int> objects, linked by pointers, against the same tree frozen in preorder layout:
+*   - full inorder and preorder traversals, through the same iterators, summing the values
+*   - searches of random keys, by going down from the root in the pointer based tree and by FrozenTree::lowerBound
+* The nodes of the pointer based tree are allocated one by one, in random order, so that, as in a tree built by random insertions,
+* the nodes close in the tree are not close in memory. The number of nodes is given as argument, 1 million by default, e.g.:
+*   g++ -std=c++17 -O2 FrozenTreeLayout.cpp -o FrozenTreeLayout
+*   ./FrozenTreeLayout 100000000
+* 100 million nodes take about 4GB for the pointer based tree and 1.2GB for the frozen one, for int values.
+*/
+
+//returns the duration of the call, in milliseconds
+double Measure(const function<void()>& run)
+{
+    auto start = chrono::steady_clock::now();
+    run();
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+Node<int>* LowerBound(Node<int>* node, const int key)
+{
+    Node<int>* result{nullptr};
+
+    while(node)
+    {
+        if(node->value < key)
+        {
+            node = node->right;
+        }
+        else
+        {
+            result = node;
+            node = node->left;
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t nodesCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    const size_t searchesCount{1000000};
+    mt19937_64 generator{42};
+
+    //the nodes are allocated in a random order, then linked as a complete tree, where the children of idx are 2*idx+1 and 2*idx+2
+    vector<size_t> allocationOrder(nodesCount);
+    for(size_t idx{0}; idx < nodesCount; ++idx)
+    {
+        allocationOrder[idx] = idx;
+    }
+    shuffle(allocationOrder.begin(), allocationOrder.end(), generator);
+
+    vector<unique_ptr<Node<int>>> nodes(nodesCount);
+    for(size_t idx : allocationOrder)
+    {
+        nodes[idx] = make_unique<Node<int>>(0);
+    }
+
+    for(size_t idx{1}; idx < nodesCount; ++idx)
+    {
+        if(idx % 2)
+        {
+            nodes[(idx-1)/2]->setAsLeftNode(nodes[idx].get());
+        }
+        else
+        {
+            nodes[(idx-1)/2]->setAsRightNode(nodes[idx].get());
+        }
+    }
+
+    //the even values, in inorder, make it a binary search tree, in which half of the searched keys are found
+    int value{0};
+    for(Node<int>& node : inorderRange(nodes[0].get()))
+    {
+        node.value = value;
+        value += 2;
+    }
+
+    FrozenTree<int> frozenTree{};
+    double freezeDuration = Measure([&frozenTree, &nodes](){frozenTree = FrozenTree<int>{nodes[0].get()};});
+
+    vector<int> keys(searchesCount);
+    uniform_int_distribution<int> keysDistribution{0, max(0, value - 1)};
+    for(int& key : keys)
+    {
+        key = keysDistribution(generator);
+    }
+
+    long long pointerSum{}, frozenSum{};
+    size_t pointerFound{}, frozenFound{};
+
+    double pointerInorder = Measure([&](){for(Node<int>& node : inorderRange(nodes[0].get())) pointerSum += node.value;});
+    double frozenInorder = Measure([&](){for(auto& node : inorderRange(frozenTree)) frozenSum += node.value;});
+    double pointerPreorder = Measure([&](){for(Node<int>& node : preorderRange(nodes[0].get())) pointerSum -= node.value;});
+    double frozenPreorder = Measure([&](){for(auto& node : preorderRange(frozenTree)) frozenSum -= node.value;});
+
+    double pointerSearch = Measure([&]()
+    {
+        for(int key : keys)
+        {
+            Node<int>* node = LowerBound(nodes[0].get(), key);
+            pointerFound += (node && node->value == key);
+        }
+    });
+
+    double frozenSearch = Measure([&]()
+    {
+        for(int key : keys)
+        {
+            frozenFound += (frozenTree.find(key) != FrozenTree<int>::nullIndex);
+        }
+    });
+
+    cout<<nodesCount<<" nodes, frozen in "<<freezeDuration<<" ms"<<endl;
+    cout<<setw(22)<<""<<setw(14)<<"pointers ms"<<setw(14)<<"frozen ms"<<endl;
+    cout<<setw(22)<<"inorder traversal"<<setw(14)<<pointerInorder<<setw(14)<<frozenInorder<<endl;
+    cout<<setw(22)<<"preorder traversal"<<setw(14)<<pointerPreorder<<setw(14)<<frozenPreorder<<endl;
+    cout<<setw(22)<<"1M random searches"<<setw(14)<<pointerSearch<<setw(14)<<frozenSearch<<endl;
+
+    if(pointerSum != frozenSum || pointerFound != frozenFound)
+    {
+        cout<<"  results differ: "<<pointerSum<<" "<<frozenSum<<" "<<pointerFound<<" "<<frozenFound<<endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
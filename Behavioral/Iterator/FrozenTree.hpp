@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "NodeTraversals.hpp"
+#include "NodeIterators.hpp"
+
+/*
+* Read only copy of a tree, for trees which are built once, then traversed and searched many times. The nodes are stored in a
+* single array, in preorder: the root is at index 1, a node having a left child is followed by it, and its right child comes after
+* its whole left subtree. Thus, a node only needs the indices of its right child and of its parent, which are half the size of
+* pointers, and the nodes are visited in the order of the array by a preorder traversal, and almost so by the other ones, as a
+* subtree takes a contiguous range of the array. A search going down the tree reads the left child next to its parent, whilst
+* the right child is prefetched before the comparison deciding which of them is needed.
+*
+* The frozen tree has the same shape as the source tree, so its preorder, inorder and postorder sequences are the ones of the
+* source tree. If the source tree is a binary search tree, whose inorder sequence is sorted, so is the frozen tree, which can be
+* searched by lowerBound and find. The Eytzinger and van Emde Boas layouts were not chosen, although they need no links at all
+* and pack the top levels better, as they only hold complete trees, so the tree would have to be rebalanced, changing its shape.
+*
+* The traversals are performed by the same iterators as for Node<T> trees (see NodeIterators.hpp), through FrozenTreeTraits,
+* the handles being the indices in the array. The preorder traversal is just a loop over the array.
+*/
+template<class T>
+class FrozenTree
+{
+    public:
+    using index_type = uint32_t;
+
+    //the handle of a missing node, as the index 0 is not used
+    static constexpr index_type nullIndex{0};
+
+    //the traversals give access to node.value, same as for Node<T>, the links being only used by the tree
+    class FrozenNode
+    {
+        public:
+        T value;
+
+        FrozenNode(const T& value, const index_type parent) : value{value}, parent{parent} {};
+
+        private:
+        friend class FrozenTree;
+
+        index_type right{nullIndex};
+        index_type parent{nullIndex};
+    };
+
+    FrozenTree() = default;
+
+    //copies the values and the shape of the tree rooted in root, which is not modified
+    explicit FrozenTree(Node<T>* root)
+    {
+        freeze(root);
+    }
+
+    size_t size() const {return mNodes.empty() ? 0 : mNodes.size() - 1;};
+    bool empty() const {return size() == 0;};
+    index_type root() const {return empty() ? nullIndex : 1;};
+
+    //the next node in the array is the left child if its parent is node, unless it is the right child of a node with no left child
+    index_type left(const index_type node) const
+    {
+        return (node < size() && mNodes[node].right != node + 1 && mNodes[node + 1].parent == node) ? node + 1 : nullIndex;
+    };
+    index_type right(const index_type node) const {return mNodes[node].right;};
+    index_type parent(const index_type node) const {return mNodes[node].parent;};
+
+    const FrozenNode& operator[](const index_type node) const {return mNodes[node];};
+
+    //the nodes in preorder, which is the order of the array
+    const FrozenNode* begin() const {return mNodes.data() + 1;};
+    const FrozenNode* end() const {return mNodes.data() + mNodes.size();};
+
+    /*
+    * Returns the index of the first node, in inorder, whose value is not less than key, or nullIndex if there is none.
+    * The inorder sequence must be sorted.
+    */
+    index_type lowerBound(const T& key) const
+    {
+        index_type result{nullIndex};
+
+        for(index_type node{root()}; node != nullIndex; )
+        {
+#if defined(__GNUC__)
+            //the left child is next to node, so only the right one may be in another cache line
+            __builtin_prefetch(mNodes.data() + mNodes[node].right);
+#endif
+            if(mNodes[node].value < key)
+            {
+                node = mNodes[node].right;
+            }
+            else
+            {
+                result = node;
+                node = left(node);
+            }
+        }
+
+        return result;
+    }
+
+    //returns the index of a node whose value is equal to key, or nullIndex if there is none
+    index_type find(const T& key) const
+    {
+        const index_type node = lowerBound(key);
+
+        return (node != nullIndex && !(key < mNodes[node].value)) ? node : nullIndex;
+    }
+
+    private:
+    //index 0 is a placeholder, so that no node has the index nullIndex
+    vector<FrozenNode> mNodes;
+
+    void freeze(Node<T>* root);
+};
+
+//lets the iterators in NodeIterators.hpp traverse a FrozenTree, the handles being the nodes indices
+template<class T>
+struct FrozenTreeTraits
+{
+    using handle_type = typename FrozenTree<T>::index_type;
+    using value_type = const typename FrozenTree<T>::FrozenNode;
+
+    static constexpr handle_type nullHandle{FrozenTree<T>::nullIndex};
+
+    const FrozenTree<T>* tree{nullptr};
+
+    FrozenTreeTraits() = default;
+    FrozenTreeTraits(const FrozenTree<T>& tree) : tree{&tree} {};
+
+    handle_type left(handle_type node) const {return tree->left(node);};
+    handle_type right(handle_type node) const {return tree->right(node);};
+    handle_type parent(handle_type node) const {return tree->parent(node);};
+    value_type& get(handle_type node) const {return (*tree)[node];};
+};
+
+template<class T>
+using FrozenPreorderIterator = BasicPreorderIterator<FrozenTreeTraits<T>>;
+template<class T>
+using FrozenInorderIterator = BasicInorderIterator<FrozenTreeTraits<T>>;
+template<class T>
+using FrozenPostorderIterator = BasicPostorderIterator<FrozenTreeTraits<T>>;
+
+template<class T>
+TraversalRange<FrozenPreorderIterator<T>> preorderRange(const FrozenTree<T>& tree)
+{
+    return {FrozenPreorderIterator<T>{tree.root(), tree}, FrozenPreorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<FrozenInorderIterator<T>> inorderRange(const FrozenTree<T>& tree)
+{
+    return {FrozenInorderIterator<T>{tree.root(), tree}, FrozenInorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<FrozenPostorderIterator<T>> postorderRange(const FrozenTree<T>& tree)
+{
+    return {FrozenPostorderIterator<T>{tree.root(), tree}, FrozenPostorderIterator<T>{}};
+}
+
+template<class T>
+void FrozenTree<T>::freeze(Node<T>* root)
+{
+    mNodes.clear();
+
+    if(!root)
+    {
+        return;
+    }
+
+    //the placeholder at index 0 is a copy of the root value, so T does not need to be default constructible
+    mNodes.emplace_back(root->value, nullIndex);
+
+    //preorder traversal by an explicit stack, so that degenerate trees, as deep as they are large, do not overflow the call stack
+    struct PendingNode
+    {
+        Node<T>* node;
+        index_type parentIdx;
+        bool isRightChild;
+    };
+    vector<PendingNode> pendingNodes{{root, nullIndex, false}};
+
+    while(!pendingNodes.empty())
+    {
+        const auto [node, parentIdx, isRightChild] = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        const index_type nodeIdx = static_cast<index_type>(mNodes.size());
+        mNodes.emplace_back(node->value, parentIdx);
+
+        //the left child follows its parent, whilst the right child is only known once the left subtree is frozen
+        if(isRightChild)
+        {
+            mNodes[parentIdx].right = nodeIdx;
+        }
+
+        if(node->right)
+        {
+            pendingNodes.push_back({node->right, nodeIdx, true});
+        }
+        if(node->left)
+        {
+            pendingNodes.push_back({node->left, nodeIdx, false});
+        }
+    }
+}
\ No newline at end of file
@@ -2,195 +2,528 @@
 
 #include "Iterator.hpp"
 #include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+using namespace std;
 
+//by default, the inline buffer takes at most 64 bytes, a cache line, and it is not used for elements larger than that
 template<class T>
-class IterableClass
+constexpr size_t getDefaultInlineCapacity()
+{
+    return sizeof(T) <= 64 ? 64 / sizeof(T) : 0;
+}
+
+//the inline buffer of IterableClass, an empty base class when there is no room for any element, so it takes no space at all
+template<class T, size_t Capacity>
+class IterableInlineStorage
+{
+    protected:
+    alignas(T) unsigned char mInlineBuffer[Capacity * sizeof(T)];
+
+    T* getInlineBuffer() {return reinterpret_cast<T*>(mInlineBuffer);};
+    const T* getInlineBuffer() const {return reinterpret_cast<const T*>(mInlineBuffer);};
+};
+
+template<class T>
+class IterableInlineStorage<T, 0>
+{
+    protected:
+    T* getInlineBuffer() {return nullptr;};
+    const T* getInlineBuffer() const {return nullptr;};
+};
+
+/*
+* Dynamic array, which holds mLength elements in a buffer having room for mCapacity elements. The memory beyond the last element
+* is raw storage, where no object is constructed: the elements are constructed in place when added and destroyed when removed, so
+* types without a default constructor can be stored and no element is default constructed, then overwritten by a copy.
+*
+* When the buffer is full, its capacity is doubled, so appending N elements performs O(log N) reallocations and copies each element
+* O(1) times on average, instead of growing by one element at each append, which copies the whole buffer each time, that is O(N^2).
+* On reallocation, the elements are moved to the new buffer, unless their move constructor may throw and they can be copied, in which
+* case they are copied, so that the old buffer is left untouched if an exception is thrown.
+*
+* Small buffer optimization: the first InlineCapacity elements are stored in a buffer inside the object itself, so collections which
+* stay that short never allocate. The heap is used only when they grow beyond it. As a consequence, moving a short collection moves
+* its elements one by one, instead of stealing the buffer.
+*
+* The memory beyond the inline buffer is obtained from Allocator, which also constructs and destroys the elements, like the allocator
+* of std::vector. Thus, the buffers can come from a memory pool, e.g. a pmr::monotonic_buffer_resource, through
+* pmr::polymorphic_allocator<T>, which is also passed to the elements which use allocators themselves, such as pmr::string.
+*/
+template<class T, class Allocator = allocator<T>, size_t InlineCapacity = getDefaultInlineCapacity<T>()>
+class IterableClass : private IterableInlineStorage<T, InlineCapacity>
 {
     private:
-    T* mBuffer;
-    size_t mLength;
-    //index of last added element
-    size_t currentIndex;
+    using AllocatorTraits = allocator_traits<Allocator>;
+    using IterableInlineStorage<T, InlineCapacity>::getInlineBuffer;
+    static_assert(is_same_v<typename AllocatorTraits::value_type, T>, "the allocator must allocate elements of type T");
 
-    public:
-    using iterator = Iterator<T>;
-    IterableClass(const size_t length):mLength{length}, currentIndex{0}
+    Allocator mAllocator;
+    T* mBuffer{nullptr};
+    size_t mLength{0};
+    size_t mCapacity{0};
+
+    //swapping elements of the inline buffers moves them, so it does not throw only if moving them does not
+    static constexpr bool isNothrowSwappable{InlineCapacity == 0 || (is_nothrow_move_constructible_v<T> && is_nothrow_swappable_v<T>)};
+
+    bool isInline() const
     {
-        mBuffer = new T[length];
+        return InlineCapacity > 0 && mBuffer == getInlineBuffer();
     }
 
-    IterableClass(const initializer_list<T>& elements):mLength{elements.size()}, currentIndex{mLength-1}
+    //starts with the inline buffer, if any, without allocating
+    void resetToInlineBuffer()
     {
-        mBuffer = new T[mLength];
-        copy(elements.begin(), elements.end(), mBuffer);
+        mBuffer = getInlineBuffer();
+        mCapacity = InlineCapacity;
+        mLength = 0;
     }
 
-    ~IterableClass()
+    //raw memory for capacity elements, where no object is constructed yet; the inline buffer is used when large enough
+    T* allocate(const size_t capacity)
     {
-        if(mBuffer)
+        if(capacity <= InlineCapacity)
         {
-            delete [] mBuffer;
+            return getInlineBuffer();
         }
+
+        return AllocatorTraits::allocate(mAllocator, capacity);
     }
 
-    //perform deep copy
-    IterableClass(const IterableClass& source)
+    void deallocate(T* buffer, const size_t capacity)
+    {
+        if(buffer && buffer != getInlineBuffer())
+        {
+            AllocatorTraits::deallocate(mAllocator, buffer, capacity);
+        }
+    }
+
+    template<class... Args>
+    void constructElement(T* location, Args&&... args)
+    {
+        AllocatorTraits::construct(mAllocator, location, forward<Args>(args)...);
+    }
+
+    void destroyElements()
+    {
+        for(size_t idx{0}; idx < mLength; ++idx)
+        {
+            AllocatorTraits::destroy(mAllocator, mBuffer + idx);
+        }
+
+        mLength = 0;
+    }
+
+    //destroys the elements, then frees the heap buffer, if any
+    void release()
+    {
+        destroyElements();
+        deallocate(mBuffer, mCapacity);
+        resetToInlineBuffer();
+    }
+
+    //moves, or copies, the elements to raw memory; if an exception is thrown, the elements constructed there are destroyed
+    void relocateElements(T* source, const size_t count, T* destination)
     {
-        /*
-        * If the source element's buffer size differs from this buffer size
-        * delete this buffer then allocate new memory for this buffer so it fits the new size
-        */
-        if(source.mLength != mLength)
+        size_t constructed{0};
+
+        try
         {
-            if(mBuffer)
+            for(; constructed < count; ++constructed)
             {
-                delete [] mBuffer;
+                if constexpr(is_nothrow_move_constructible_v<T> || !is_copy_constructible_v<T>)
+                {
+                    constructElement(destination + constructed, move(source[constructed]));
+                }
+                else
+                {
+                    constructElement(destination + constructed, as_const(source[constructed]));
+                }
             }
-            
-            mLength = source.mLength;
-            mBuffer = new T[mLength];
         }
+        catch(...)
+        {
+            for(size_t idx{0}; idx < constructed; ++idx)
+            {
+                AllocatorTraits::destroy(mAllocator, destination + idx);
+            }
 
-        // at this point both this and source buffers lengths should be equal, so just copy the elements
-        copy(source.cbegin(), source.cend(), mBuffer);
+            throw;
+        }
+    }
 
-        currentIndex = mLength - 1;
+    /*
+    * Moves, or copies, the elements to a new buffer of the given capacity, which should not be lower than the length.
+    * If an exception is thrown, the elements constructed in the new buffer are destroyed and this object is not modified.
+    * A heap buffer shrunk to a capacity fitting the inline buffer is replaced by the latter.
+    */
+    void reallocate(size_t newCapacity)
+    {
+        if(newCapacity <= InlineCapacity)
+        {
+            newCapacity = InlineCapacity;
+        }
+
+        T* newBuffer = allocate(newCapacity);
+
+        if(newBuffer == mBuffer)
+        {
+            return;
+        }
+
+        try
+        {
+            relocateElements(mBuffer, mLength, newBuffer);
+        }
+        catch(...)
+        {
+            deallocate(newBuffer, newCapacity);
+            throw;
+        }
+
+        const size_t length = mLength;
+        destroyElements();
+        deallocate(mBuffer, mCapacity);
+
+        mBuffer = newBuffer;
+        mLength = length;
+        mCapacity = newCapacity;
     }
 
-    IterableClass& operator=(const IterableClass& source)
+    size_t getGrownCapacity(const size_t minCapacity) const
     {
-        //check if it is performed assignment against self using pointer comparison, not object comparison
-        if(&source == this)
+        return max(minCapacity, mCapacity ? 2 * mCapacity : size_t{4});
+    }
+
+    //appends copies of the elements in [first, last), reallocating the buffer at most once
+    template<class InputIterator>
+    void appendElements(InputIterator first, InputIterator last, const size_t count)
+    {
+        if(mLength + count > mCapacity)
         {
-            return *this;
+            reallocate(getGrownCapacity(mLength + count));
         }
 
-        /*
-        * If the source element's buffer size differs from this buffer size
-        * delete this buffer then allocate new memory for this buffer so it fits the new size
-        */
-        if(source.mLength != mLength)
+        for(; first != last; ++first)
         {
-            if(mBuffer)
+            constructElement(mBuffer + mLength, *first);
+            ++mLength;
+        }
+    }
+
+    /*
+    * Exchanges the elements with other, not the allocators. The heap buffers are exchanged, whilst the elements in the inline buffers
+    * are moved, or copied if their move constructor may throw, so if an inline element throws whilst being copied to the heap side,
+    * both objects are left as they were. Only swapping 2 inline buffers may leave them partially swapped, if moving an element throws.
+    */
+    void swapStorage(IterableClass& other) noexcept(isNothrowSwappable)
+    {
+        if(!isInline() && !other.isInline())
+        {
+            std::swap(mBuffer, other.mBuffer);
+            std::swap(mLength, other.mLength);
+            std::swap(mCapacity, other.mCapacity);
+            return;
+        }
+
+        if(isInline() && other.isInline())
+        {
+            IterableClass& shorter = mLength <= other.mLength ? *this : other;
+            IterableClass& longer = mLength <= other.mLength ? other : *this;
+
+            for(size_t idx{0}; idx < shorter.mLength; ++idx)
+            {
+                using std::swap;
+                swap(shorter.mBuffer[idx], longer.mBuffer[idx]);
+            }
+
+            shorter.relocateElements(longer.mBuffer + shorter.mLength, longer.mLength - shorter.mLength, shorter.mBuffer + shorter.mLength);
+            for(size_t idx{shorter.mLength}; idx < longer.mLength; ++idx)
             {
-                delete [] mBuffer;
+                AllocatorTraits::destroy(longer.mAllocator, longer.mBuffer + idx);
             }
 
-            mLength = source.mLength;
-            mBuffer = new T[mLength];
+            std::swap(mLength, other.mLength);
+            return;
         }
 
-        // at this point both this and source buffers lengths should be equal, so just copy the elements
-        copy(source.cbegin(), source.cend(), mBuffer);
+        //the inline elements move to the inline buffer of the other side, which then gives its heap buffer
+        IterableClass& inlineSide = isInline() ? *this : other;
+        IterableClass& heapSide = isInline() ? other : *this;
 
-        currentIndex = mLength - 1;
+        heapSide.relocateElements(inlineSide.mBuffer, inlineSide.mLength, heapSide.getInlineBuffer());
 
-        return *this;
+        const size_t inlineLength = inlineSide.mLength;
+        inlineSide.destroyElements();
+
+        inlineSide.mBuffer = exchange(heapSide.mBuffer, heapSide.getInlineBuffer());
+        inlineSide.mLength = exchange(heapSide.mLength, inlineLength);
+        inlineSide.mCapacity = exchange(heapSide.mCapacity, InlineCapacity);
     }
 
-    IterableClass(IterableClass&& source)
+    //takes over the elements of source, which is left empty, stealing its heap buffer if allowed, otherwise moving the elements
+    void takeElementsOf(IterableClass& source, const bool canStealBuffer)
     {
-        //firstly erase old resources
-        if(mBuffer)
+        if(!source.isInline() && source.mBuffer && canStealBuffer)
+        {
+            mBuffer = exchange(source.mBuffer, nullptr);
+            mLength = exchange(source.mLength, 0);
+            mCapacity = exchange(source.mCapacity, 0);
+            source.resetToInlineBuffer();
+            return;
+        }
+
+        reserve(source.mLength);
+        for(size_t idx{0}; idx < source.mLength; ++idx)
         {
-            delete [] mBuffer;
+            constructElement(mBuffer + mLength, move(source.mBuffer[idx]));
+            ++mLength;
         }
+        source.release();
+    }
 
-        //then point to the new ones
-        mLength = source.mLength;
-        mBuffer = source.mBuffer;
+    public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using value_type = T;
+    using allocator_type = Allocator;
 
-        //leave source in well defined state
-        source.mBuffer = nullptr;
-        source.mLength = 0;
+    IterableClass() : IterableClass(Allocator()) {};
 
-        currentIndex = mLength - 1;
+    explicit IterableClass(const Allocator& allocator) : mAllocator{allocator}
+    {
+        resetToInlineBuffer();
+    }
+
+    //holds length value initialized elements
+    IterableClass(const size_t length, const Allocator& allocator = Allocator()) : IterableClass(allocator)
+    {
+        reserve(length);
+        for(; mLength < length; ++mLength)
+        {
+            constructElement(mBuffer + mLength);
+        }
+    }
+
+    IterableClass(const initializer_list<T>& elements, const Allocator& allocator = Allocator()) : IterableClass(allocator)
+    {
+        reserve(elements.size());
+        appendElements(elements.begin(), elements.end(), elements.size());
+    }
+
+    ~IterableClass()
+    {
+        release();
+    }
+
+    //perform deep copy, in a buffer just large enough for the source elements
+    IterableClass(const IterableClass& source)
+    : IterableClass(AllocatorTraits::select_on_container_copy_construction(source.mAllocator))
+    {
+        reserve(source.mLength);
+        appendElements(source.cbegin(), source.cend(), source.mLength);
+    }
+
+    IterableClass& operator=(const IterableClass& source)
+    {
+        //check if it is performed assignment against self using pointer comparison, not object comparison
+        if(&source == this)
+        {
+            return *this;
+        }
+
+        //copy and swap: if copying throws, this object is not modified
+        const bool propagatesAllocator = AllocatorTraits::propagate_on_container_copy_assignment::value;
+        //not braces, which would pick the initializer_list constructor if T is constructible from the allocator, e.g. std::any
+        IterableClass copy(propagatesAllocator ? source.mAllocator : mAllocator);
+
+        //if the elements may throw when moved, the copy is made on the heap, so swapping with it moves no element of the copy
+        copy.reserve((!isNothrowSwappable && source.mLength > 0) ? max(source.mLength, InlineCapacity + 1) : source.mLength);
+        copy.appendElements(source.cbegin(), source.cend(), source.mLength);
+
+        swapStorage(copy);
+
+        //the old elements, now in the copy, are freed by the allocator which allocated them
+        if constexpr(AllocatorTraits::propagate_on_container_copy_assignment::value)
+        {
+            std::swap(mAllocator, copy.mAllocator);
+        }
+
+        return *this;
+    }
+
+    //the heap buffer is stolen, so no element is copied, nor moved, unless the elements are in the inline buffer
+    IterableClass(IterableClass&& source) noexcept(is_nothrow_move_constructible_v<T>) : IterableClass(move(source.mAllocator))
+    {
+        takeElementsOf(source, true);
     }
 
     IterableClass& operator=(IterableClass&& source)
+    noexcept(is_nothrow_move_constructible_v<T> && (AllocatorTraits::propagate_on_container_move_assignment::value ||
+                                                    AllocatorTraits::is_always_equal::value))
     {
         //check if it is performed move assignment against self using pointer comparison, not object comparison
         if(&source == this)
         {
             return *this;
         }
+
         //firstly erase old resources
-        if(mBuffer)
+        release();
+
+        //then take the new ones; a buffer allocated by a different allocator cannot be freed by this one, so it is not stolen
+        if constexpr(AllocatorTraits::propagate_on_container_move_assignment::value)
         {
-            delete [] mBuffer;
+            mAllocator = move(source.mAllocator);
+            takeElementsOf(source, true);
+        }
+        else
+        {
+            takeElementsOf(source, mAllocator == source.mAllocator);
         }
 
-        //then point to the new ones
-        mLength = source.mLength;
-        mBuffer = source.mBuffer;
-
-        //leave source in well defined state
-        source.mBuffer = nullptr;
-        source.mLength = 0;
+        return *this;
+    }
 
-        currentIndex = mLength - 1;
+    //as for std::vector, the allocators are swapped only if they propagate on swap, otherwise they must be equal
+    void swap(IterableClass& other) noexcept(isNothrowSwappable)
+    {
+        if constexpr(AllocatorTraits::propagate_on_container_swap::value)
+        {
+            std::swap(mAllocator, other.mAllocator);
+        }
 
-        return *this;
+        swapStorage(other);
     }
 
-    //begin and end provide head and tail pointers used for iterating
-    T* begin() {return mBuffer;};
-    T* end() {return mBuffer + mLength;};
-    const T* cbegin() const {return mBuffer;};
-    const T* cend() const {return mBuffer + mLength;};
+    allocator_type get_allocator() const {return mAllocator;};
 
-    T* rbegin() {return mBuffer + mLength - 1;};
-    T* rend() {return mBuffer-1;};
-    const T* crbegin() const {return mBuffer + mLength - 1;};
-    const T* crend() const {return mBuffer-1;};
+    size_t size() const {return mLength;};
+    size_t capacity() const {return mCapacity;};
+    bool empty() const {return mLength == 0;};
+    //whether the elements are stored in the inline buffer, or there are none, that is no heap memory is used
+    bool isSmall() const {return isInline() || !mBuffer;};
 
-    void addElementBack(const size_t index, const T& value)
+    T& operator[](const size_t index) {return mBuffer[index];};
+    const T& operator[](const size_t index) const {return mBuffer[index];};
+
+    //makes room for newCapacity elements, so adding elements up to that count does not reallocate
+    void reserve(const size_t newCapacity)
     {
-        if(index < mLength)
+        if(newCapacity > mCapacity)
         {
-            mBuffer[index] = value;
-            ++currentIndex;
+            reallocate(newCapacity);
         }
-        else
+    }
+
+    //releases the memory beyond the last element, moving the elements back to the inline buffer if they fit
+    void shrink_to_fit()
+    {
+        if(mCapacity > mLength)
         {
-            // have another temporary pointer to the old buffer
-            T* tempBuffer = mBuffer;
-            mBuffer = nullptr;
+            reallocate(mLength);
+        }
+    }
 
-            //enlarge the buffer and length by 1
-            ++mLength;
-            mBuffer = new T[mLength];
+    //destroys the elements, keeping the buffer
+    void clear()
+    {
+        destroyElements();
+    }
 
-            copy(tempBuffer, tempBuffer + mLength - 1, mBuffer);
-            mBuffer[mLength-1] = value;
+    /*
+    * Constructs the element in place, at the end, from the given arguments. When the buffer is full, the element is constructed
+    * in the new buffer before the existing elements are moved there, so the arguments may refer to elements of this object.
+    */
+    template<class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(mLength < mCapacity)
+        {
+            constructElement(mBuffer + mLength, forward<Args>(args)...);
+            return mBuffer[mLength++];
+        }
+
+        const size_t newCapacity = getGrownCapacity(mLength + 1);
+        T* newBuffer = allocate(newCapacity);
 
-            currentIndex = mLength - 1; 
+        try
+        {
+            constructElement(newBuffer + mLength, forward<Args>(args)...);
         }
+        catch(...)
+        {
+            deallocate(newBuffer, newCapacity);
+            throw;
+        }
+
+        try
+        {
+            relocateElements(mBuffer, mLength, newBuffer);
+        }
+        catch(...)
+        {
+            AllocatorTraits::destroy(mAllocator, newBuffer + mLength);
+            deallocate(newBuffer, newCapacity);
+            throw;
+        }
+
+        const size_t length = mLength;
+        destroyElements();
+        deallocate(mBuffer, mCapacity);
+
+        mBuffer = newBuffer;
+        mLength = length + 1;
+        mCapacity = newCapacity;
+
+        return mBuffer[length];
     }
 
-    void addElementsBack(const initializer_list<T>& elements)
+    void push_back(const T& value) {emplace_back(value);};
+    void push_back(T&& value) {emplace_back(move(value));};
+
+    void pop_back()
+    {
+        AllocatorTraits::destroy(mAllocator, mBuffer + --mLength);
+    }
+
+    T* data() {return mBuffer;};
+    const T* data() const {return mBuffer;};
+
+    //begin and end provide head and tail iterators used for iterating
+    iterator begin() {return iterator{mBuffer};};
+    iterator end() {return iterator{mBuffer + mLength};};
+    const_iterator begin() const {return const_iterator{mBuffer};};
+    const_iterator end() const {return const_iterator{mBuffer + mLength};};
+    const_iterator cbegin() const {return const_iterator{mBuffer};};
+    const_iterator cend() const {return const_iterator{mBuffer + mLength};};
+
+    //the reverse iterators start with the last element and their end is before the first one, without pointing there
+    reverse_iterator rbegin() {return reverse_iterator{end()};};
+    reverse_iterator rend() {return reverse_iterator{begin()};};
+    const_reverse_iterator crbegin() const {return const_reverse_iterator{cend()};};
+    const_reverse_iterator crend() const {return const_reverse_iterator{cbegin()};};
+
+    //overwrites the element at index, if there is one, otherwise appends value
+    void addElementBack(const size_t index, const T& value)
     {
-        if(elements.size() < mLength)
+        if(index < mLength)
         {
-            for(size_t idx = currentIndex; idx < elements.size(); ++idx)
-            {
-                mBuffer[idx] = *(elements.begin() + idx - currentIndex);
-            }
+            mBuffer[index] = value;
         }
         else
         {
-            // have another temporary pointer to the old buffer
-            T* tempBuffer = mBuffer;
-            size_t tempLength = mLength;
-            mBuffer = nullptr;
-
-            //enlarge the buffer and length by 1
-            mLength += elements.size();
-            mBuffer = new T[mLength];
-
-            copy(tempBuffer, tempBuffer + tempLength, mBuffer);
-            copy(elements.begin(), elements.end(), mBuffer+tempLength);
+            emplace_back(value);
         }
     }
-};
 
+    //appends the elements, reallocating the buffer at most once
+    void addElementsBack(const initializer_list<T>& elements)
+    {
+        appendElements(elements.begin(), elements.end(), elements.size());
+    }
+};
@@ -1,44 +1,106 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+using namespace std;
+
+/*
+* Iterator over elements stored contiguously, as those of IterableClass. As it wraps a pointer, it supports all the operations
+* of a pointer: besides ++ and !=, needed by range based for loops, it can be decremented, moved by any offset, subtracted and
+* compared, in constant time. Thus it is a random access iterator, usable with all the std algorithms, including the ones taking
+* an execution policy, such as sort(execution::par_unseq, ...). Dereferencing returns a reference, so the elements are not copied.
+*
+* Since C++20, it is also declared a contiguous iterator, so the ranges algorithms and views know the elements are adjacent
+* in memory, hence the containers can be converted to span and the algorithms can work on raw memory.
+* Iterator<const T> is the const iterator, which an Iterator<T> converts to.
+*/
 template<class T>
 class Iterator
 {
     private:
-    T* currentElem;
+    T* currentElem{nullptr};
 
     public:
+    using iterator_category = random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = contiguous_iterator_tag;
+#endif
+    using value_type = remove_cv_t<T>;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() = default;
     Iterator(T* startPtr):currentElem{startPtr}{};
 
-    Iterator(const Iterator& it)
+    //an iterator to mutable elements converts to an iterator to const elements, not the other way around
+    template<class U, enable_if_t<is_same_v<const U, T>, int> = 0>
+    Iterator(const Iterator<U>& it):currentElem{it.operator->()}{};
+
+    Iterator& operator=(T* it)
     {
-        currentElem = it.currentElem;
+        currentElem = it;
+        return *this;
     }
 
-    Iterator& operator=(const Iterator& it)
+    reference operator*() const {return *currentElem;};
+    pointer operator->() const {return currentElem;};
+    reference operator[](const difference_type offset) const {return currentElem[offset];};
+
+    Iterator& operator++()
     {
-        currentElem = it.currentElem;
+        ++currentElem;
+
         return *this;
     }
 
-    Iterator& operator=(T* it)
+    Iterator operator++(int)
     {
-        currentElem = it;
+        Iterator result{*this};
+        ++currentElem;
+
+        return result;
+    }
+
+    Iterator& operator--()
+    {
+        --currentElem;
+
         return *this;
     }
 
-    bool operator!=(const Iterator& it)
+    Iterator operator--(int)
     {
-        return currentElem != it.currentElem;
+        Iterator result{*this};
+        --currentElem;
+
+        return result;
     }
 
-    Iterator& operator++()
+    Iterator& operator+=(const difference_type offset)
     {
-        ++currentElem;
+        currentElem += offset;
 
         return *this;
     }
 
-    T operator*(){return *currentElem;};
+    Iterator& operator-=(const difference_type offset)
+    {
+        currentElem -= offset;
 
-};
+        return *this;
+    }
+
+    friend Iterator operator+(const Iterator& it, const difference_type offset) {return Iterator{it.currentElem + offset};};
+    friend Iterator operator+(const difference_type offset, const Iterator& it) {return Iterator{it.currentElem + offset};};
+    friend Iterator operator-(const Iterator& it, const difference_type offset) {return Iterator{it.currentElem - offset};};
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem - rhs.currentElem;};
 
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem == rhs.currentElem;};
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem != rhs.currentElem;};
+    friend bool operator<(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem < rhs.currentElem;};
+    friend bool operator>(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem > rhs.currentElem;};
+    friend bool operator<=(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem <= rhs.currentElem;};
+    friend bool operator>=(const Iterator& lhs, const Iterator& rhs) {return lhs.currentElem >= rhs.currentElem;};
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "NodeIterators.hpp"
+
+/*
+* Node<T> objects are allocated one by one and linked by 3 pointers, so a traversal jumps between addresses scattered all over
+* the heap, whilst each node carries 24 bytes of links. NodeArena is an alternative storage for trees: the nodes are stored
+* contiguously, in blocks of fixed size, and they are linked by 32 bits indices instead of pointers. Thus, the links take
+* 12 bytes per node and the nodes created one after the other are neighbours in memory, so a traversal touches fewer cache lines.
+*
+* The nodes are allocated in bulk: reserve makes room for many nodes at once and allocate can create a batch of consecutive nodes.
+* They are not freed one by one, but all at once, by clear, which keeps the blocks for the next tree built in the arena.
+* As the blocks are never reallocated, references to nodes stay valid till the arena is cleared. The index of a node is its handle,
+* nullIndex standing for a missing node. The nodes can be traversed with the same iterators as Node<T> (see NodeIterators.hpp),
+* through ArenaNodeTraits.
+*
+* As nullIndex is the largest 32 bits value, an arena holds at most nullIndex nodes: allocating more throws length_error.
+*/
+template<class T>
+class NodeArena
+{
+    public:
+    using index_type = uint32_t;
+
+    static constexpr index_type nullIndex{numeric_limits<index_type>::max()};
+
+    struct ArenaNode
+    {
+        T value;
+        index_type left{nullIndex}, right{nullIndex}, parent{nullIndex};
+    };
+
+    //the number of nodes in a block is a power of 2, so the block of an index is found by a shift
+    explicit NodeArena(const size_t log2BlockSize = 12) : mBlockShift{log2BlockSize}, mBlockMask{(size_t{1} << log2BlockSize) - 1} {};
+
+    //copying a vector only reserves its size, so the nodes are copied to blocks reserved with the block size, as reserve does
+    NodeArena(const NodeArena& other) : NodeArena{other.mBlockShift}
+    {
+        reserve(other.mSize);
+
+        for(size_t blockIdx{0}; blockIdx < other.mBlocks.size(); ++blockIdx)
+        {
+            mBlocks[blockIdx].assign(other.mBlocks[blockIdx].begin(), other.mBlocks[blockIdx].end());
+        }
+
+        mSize = other.mSize;
+    }
+
+    //the moved from arena is left empty, without blocks
+    NodeArena(NodeArena&& other) noexcept : NodeArena{other.mBlockShift}
+    {
+        swap(*this, other);
+    }
+
+    NodeArena& operator=(NodeArena other) noexcept
+    {
+        swap(*this, other);
+        return *this;
+    }
+
+    friend void swap(NodeArena& lhs, NodeArena& rhs) noexcept
+    {
+        using std::swap;
+        swap(lhs.mBlocks, rhs.mBlocks);
+        swap(lhs.mBlockShift, rhs.mBlockShift);
+        swap(lhs.mBlockMask, rhs.mBlockMask);
+        swap(lhs.mSize, rhs.mSize);
+    }
+
+    size_t size() const {return mSize;};
+    size_t capacity() const {return mBlocks.size() << mBlockShift;};
+
+    ArenaNode& operator[](const index_type index) {return mBlocks[index >> mBlockShift][index & mBlockMask];};
+    const ArenaNode& operator[](const index_type index) const {return mBlocks[index >> mBlockShift][index & mBlockMask];};
+
+    //allocates the blocks needed to hold nodesCount nodes, so the nodes created afterwards do not allocate
+    void reserve(const size_t nodesCount)
+    {
+        while(capacity() < nodesCount)
+        {
+            mBlocks.emplace_back();
+            mBlocks.back().reserve(size_t{1} << mBlockShift);
+        }
+    }
+
+    /*
+    * Creates a node without children. If a parent is given, the node is attached as its left child, or as its right child if the
+    * left one is already set, like the Node(value, parent) constructor does.
+    */
+    index_type allocate(const T& value, const index_type parent = nullIndex)
+    {
+        checkIndices(1);
+        reserve(mSize + 1);
+
+        const index_type index = static_cast<index_type>(mSize++);
+        mBlocks[index >> mBlockShift].push_back(ArenaNode{value, nullIndex, nullIndex, parent});
+
+        if(parent != nullIndex)
+        {
+            ArenaNode& parentNode = (*this)[parent];
+
+            if(parentNode.left == nullIndex)
+            {
+                parentNode.left = index;
+            }
+            else if(parentNode.right == nullIndex)
+            {
+                parentNode.right = index;
+            }
+        }
+
+        return index;
+    }
+
+    //creates nodesCount unlinked nodes with the same value, having consecutive indices, and returns the index of the first one
+    index_type allocate(const size_t nodesCount, const T& value)
+    {
+        checkIndices(nodesCount);
+        reserve(mSize + nodesCount);
+
+        const index_type first = static_cast<index_type>(mSize);
+
+        for(size_t idx{0}; idx < nodesCount; ++idx, ++mSize)
+        {
+            mBlocks[mSize >> mBlockShift].push_back(ArenaNode{value});
+        }
+
+        return first;
+    }
+
+    void setAsLeftNode(const index_type parent, const index_type leftNode)
+    {
+        if((*this)[parent].left == nullIndex)
+        {
+            (*this)[parent].left = leftNode;
+            (*this)[leftNode].parent = parent;
+        }
+    }
+
+    void setAsRightNode(const index_type parent, const index_type rightNode)
+    {
+        if((*this)[parent].right == nullIndex)
+        {
+            (*this)[parent].right = rightNode;
+            (*this)[rightNode].parent = parent;
+        }
+    }
+
+    //destroys all the nodes at once, keeping the memory of the blocks
+    void clear()
+    {
+        for(vector<ArenaNode>& block : mBlocks)
+        {
+            block.clear();
+        }
+
+        mSize = 0;
+    }
+
+    private:
+    //each block is reserved with the block size upfront, thus it is never reallocated
+    vector<vector<ArenaNode>> mBlocks;
+    size_t mBlockShift;
+    size_t mBlockMask;
+    size_t mSize{0};
+
+    //throws if some of the nodesCount next nodes would not have an index, nullIndex being reserved for missing nodes
+    void checkIndices(const size_t nodesCount) const
+    {
+        if(nodesCount > nullIndex - mSize)
+        {
+            throw length_error{"NodeArena cannot index more than 2^32 - 1 nodes"};
+        }
+    }
+};
+
+//lets the iterators in NodeIterators.hpp traverse a tree stored in a NodeArena, the handles being the nodes indices
+template<class T>
+struct ArenaNodeTraits
+{
+    using handle_type = typename NodeArena<T>::index_type;
+    using value_type = typename NodeArena<T>::ArenaNode;
+
+    static constexpr handle_type nullHandle{NodeArena<T>::nullIndex};
+
+    NodeArena<T>* arena{nullptr};
+
+    ArenaNodeTraits() = default;
+    ArenaNodeTraits(NodeArena<T>& arena) : arena{&arena} {};
+
+    handle_type left(handle_type node) const {return (*arena)[node].left;};
+    handle_type right(handle_type node) const {return (*arena)[node].right;};
+    handle_type parent(handle_type node) const {return (*arena)[node].parent;};
+    value_type& get(handle_type node) const {return (*arena)[node];};
+};
+
+template<class T>
+using ArenaPreorderIterator = BasicPreorderIterator<ArenaNodeTraits<T>>;
+template<class T>
+using ArenaInorderIterator = BasicInorderIterator<ArenaNodeTraits<T>>;
+template<class T>
+using ArenaPostorderIterator = BasicPostorderIterator<ArenaNodeTraits<T>>;
+template<class T>
+using ArenaLevelOrderTraversal = BasicLevelOrderTraversal<ArenaNodeTraits<T>>;
+
+template<class T>
+TraversalRange<ArenaPreorderIterator<T>> preorderRange(NodeArena<T>& arena, typename NodeArena<T>::index_type root)
+{
+    return {ArenaPreorderIterator<T>{root, arena}, ArenaPreorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<ArenaInorderIterator<T>> inorderRange(NodeArena<T>& arena, typename NodeArena<T>::index_type root)
+{
+    return {ArenaInorderIterator<T>{root, arena}, ArenaInorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<ArenaPostorderIterator<T>> postorderRange(NodeArena<T>& arena, typename NodeArena<T>::index_type root)
+{
+    return {ArenaPostorderIterator<T>{root, arena}, ArenaPostorderIterator<T>{}};
+}
\ No newline at end of file
@@ -0,0 +1,464 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "NodeTraversals.hpp"
+
+/*
+* The iterators below do not access the nodes directly, but through a traits class, which tells how to get from a node handle
+* to its children, its parent and its data. Hence, the same traversals run over trees stored in different ways:
+*   - NodePointerTraits: the handles are pointers to Node<T>, each node being allocated on its own;
+*   - ArenaNodeTraits (see NodeArena.hpp): the handles are 32 bits indices of nodes stored contiguously in a NodeArena.
+* A traits class provides:
+*   - handle_type, the type of the handles, and nullHandle, the handle of a missing node;
+*   - value_type, the type of the node the iterators dereference to, through get(handle);
+*   - left(handle), right(handle) and parent(handle).
+* The traits may hold state, e.g. the arena holding the nodes. The iterators inherit from them, so stateless traits take no space.
+*/
+template<class T>
+struct NodePointerTraits
+{
+    using handle_type = Node<T>*;
+    using value_type = Node<T>;
+
+    static constexpr handle_type nullHandle{nullptr};
+
+    handle_type left(handle_type node) const {return node->left;};
+    handle_type right(handle_type node) const {return node->right;};
+    handle_type parent(handle_type node) const {return node->parent;};
+    value_type& get(handle_type node) const {return *node;};
+};
+
+/*
+* Iterators over the nodes of a tree, which perform the DFS traversals lazily, one node per increment, instead of
+* filling a vector with all the nodes. They do not use recursion, nor a stack: as each node knows its parent, the
+* next node is always reachable from the current one, by going down to a child or up to an ancestor. Thus, an iterator
+* only holds 2 handles, the current node and the root of the traversed (sub)tree, it never allocates and it can
+* traverse trees of any depth. Several traversals can run at once, as no state is shared between iterators.
+*
+* The end iterator holds a null current node. Incrementing an iterator while its tree is modified is undefined.
+*/
+template<class Traits>
+class BasicPreorderIterator : private Traits
+{
+    public:
+    using handle_type = typename Traits::handle_type;
+    using iterator_category = forward_iterator_tag;
+    using value_type = typename Traits::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    BasicPreorderIterator() = default;
+    explicit BasicPreorderIterator(handle_type root, const Traits& traits = Traits{}) : Traits{traits}, current{root}, root{root} {};
+
+    reference operator*() const {return Traits::get(current);};
+    pointer operator->() const {return &Traits::get(current);};
+    handle_type handle() const {return current;};
+
+    /*
+    * Root->left->right strategy: go down to the left child if any, otherwise to the right child. For a node without children,
+    * go up till reaching a node that is the left child of a parent which also has a right child: that right child is next.
+    */
+    BasicPreorderIterator& operator++()
+    {
+        const handle_type left = Traits::left(current);
+        const handle_type right = Traits::right(current);
+
+        if(left != Traits::nullHandle)
+        {
+            current = left;
+        }
+        else if(right != Traits::nullHandle)
+        {
+            current = right;
+        }
+        else
+        {
+            while(current != root)
+            {
+                const handle_type parent = Traits::parent(current);
+                const handle_type parentRight = Traits::right(parent);
+
+                if(current == Traits::left(parent) && parentRight != Traits::nullHandle)
+                {
+                    current = parentRight;
+                    return *this;
+                }
+
+                current = parent;
+            }
+
+            current = Traits::nullHandle;
+        }
+
+        return *this;
+    }
+
+    BasicPreorderIterator operator++(int)
+    {
+        BasicPreorderIterator result{*this};
+        ++(*this);
+        return result;
+    }
+
+    friend bool operator==(const BasicPreorderIterator& lhs, const BasicPreorderIterator& rhs) {return lhs.current == rhs.current;};
+    friend bool operator!=(const BasicPreorderIterator& lhs, const BasicPreorderIterator& rhs) {return lhs.current != rhs.current;};
+
+    private:
+    handle_type current{Traits::nullHandle};
+    handle_type root{Traits::nullHandle};
+};
+
+template<class Traits>
+class BasicInorderIterator : private Traits
+{
+    public:
+    using handle_type = typename Traits::handle_type;
+    using iterator_category = forward_iterator_tag;
+    using value_type = typename Traits::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    BasicInorderIterator() = default;
+    //the traversal starts with the leftmost node
+    explicit BasicInorderIterator(handle_type root, const Traits& traits = Traits{}) : Traits{traits}, current{leftmost(root)}, root{root} {};
+
+    reference operator*() const {return Traits::get(current);};
+    pointer operator->() const {return &Traits::get(current);};
+    handle_type handle() const {return current;};
+
+    /*
+    * Left->root->right strategy: if the node has a right child, the next one is the leftmost node of the right subtree.
+    * Otherwise, go up while coming from a right child, as those parents were already visited. The next node is the
+    * parent reached from a left child.
+    */
+    BasicInorderIterator& operator++()
+    {
+        const handle_type right = Traits::right(current);
+
+        if(right != Traits::nullHandle)
+        {
+            current = leftmost(right);
+            return *this;
+        }
+
+        while(current != root && current == Traits::right(Traits::parent(current)))
+        {
+            current = Traits::parent(current);
+        }
+
+        current = (current == root) ? Traits::nullHandle : Traits::parent(current);
+
+        return *this;
+    }
+
+    BasicInorderIterator operator++(int)
+    {
+        BasicInorderIterator result{*this};
+        ++(*this);
+        return result;
+    }
+
+    friend bool operator==(const BasicInorderIterator& lhs, const BasicInorderIterator& rhs) {return lhs.current == rhs.current;};
+    friend bool operator!=(const BasicInorderIterator& lhs, const BasicInorderIterator& rhs) {return lhs.current != rhs.current;};
+
+    private:
+    handle_type current{Traits::nullHandle};
+    handle_type root{Traits::nullHandle};
+
+    handle_type leftmost(handle_type node) const
+    {
+        if(node == Traits::nullHandle)
+        {
+            return node;
+        }
+
+        for(handle_type left = Traits::left(node); left != Traits::nullHandle; left = Traits::left(node))
+        {
+            node = left;
+        }
+
+        return node;
+    }
+};
+
+template<class Traits>
+class BasicPostorderIterator : private Traits
+{
+    public:
+    using handle_type = typename Traits::handle_type;
+    using iterator_category = forward_iterator_tag;
+    using value_type = typename Traits::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    BasicPostorderIterator() = default;
+    explicit BasicPostorderIterator(handle_type root, const Traits& traits = Traits{}) : Traits{traits}, current{firstInPostorder(root)}, root{root} {};
+
+    reference operator*() const {return Traits::get(current);};
+    pointer operator->() const {return &Traits::get(current);};
+    handle_type handle() const {return current;};
+
+    /*
+    * Left->right->root strategy: the root of the traversed tree is the last node. Otherwise, if the node is the left child
+    * of a parent having a right child, the next node is the first one of the right subtree. If not, the next node is the parent.
+    */
+    BasicPostorderIterator& operator++()
+    {
+        if(current == root)
+        {
+            current = Traits::nullHandle;
+            return *this;
+        }
+
+        const handle_type parent = Traits::parent(current);
+        const handle_type parentRight = Traits::right(parent);
+
+        current = (current == Traits::left(parent) && parentRight != Traits::nullHandle) ? firstInPostorder(parentRight) : parent;
+
+        return *this;
+    }
+
+    BasicPostorderIterator operator++(int)
+    {
+        BasicPostorderIterator result{*this};
+        ++(*this);
+        return result;
+    }
+
+    friend bool operator==(const BasicPostorderIterator& lhs, const BasicPostorderIterator& rhs) {return lhs.current == rhs.current;};
+    friend bool operator!=(const BasicPostorderIterator& lhs, const BasicPostorderIterator& rhs) {return lhs.current != rhs.current;};
+
+    private:
+    handle_type current{Traits::nullHandle};
+    handle_type root{Traits::nullHandle};
+
+    //the first node visited in a subtree is reached by going down, preferably to the left, till a node without children
+    handle_type firstInPostorder(handle_type node) const
+    {
+        while(node != Traits::nullHandle)
+        {
+            const handle_type left = Traits::left(node);
+            const handle_type next = (left != Traits::nullHandle) ? left : Traits::right(node);
+
+            if(next == Traits::nullHandle)
+            {
+                break;
+            }
+
+            node = next;
+        }
+
+        return node;
+    }
+};
+
+//the iterators over trees made of Node<T> objects, linked by pointers
+template<class T>
+using PreorderIterator = BasicPreorderIterator<NodePointerTraits<T>>;
+template<class T>
+using InorderIterator = BasicInorderIterator<NodePointerTraits<T>>;
+template<class T>
+using PostorderIterator = BasicPostorderIterator<NodePointerTraits<T>>;
+
+//a pair of iterators, so the traversals can be used in range based for loops and with std algorithms
+template<class IteratorType>
+struct TraversalRange
+{
+    IteratorType first, last;
+
+    IteratorType begin() const {return first;};
+    IteratorType end() const {return last;};
+};
+
+template<class T>
+TraversalRange<PreorderIterator<T>> preorderRange(Node<T>* root)
+{
+    return {PreorderIterator<T>{root}, PreorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<InorderIterator<T>> inorderRange(Node<T>* root)
+{
+    return {InorderIterator<T>{root}, InorderIterator<T>{}};
+}
+
+template<class T>
+TraversalRange<PostorderIterator<T>> postorderRange(Node<T>* root)
+{
+    return {PostorderIterator<T>{root}, PostorderIterator<T>{}};
+}
+
+/*
+* Queue storing its elements in a circular buffer, whose capacity is doubled when it is full. Unlike std::queue, which is
+* a deque allocating and freeing blocks as elements are pushed and popped, the buffer is kept when the queue is cleared,
+* so a queue that is reused does not allocate anymore, once it has grown to the size required by the traversed trees.
+*/
+template<class ValueType>
+class RingBuffer
+{
+    public:
+    bool empty() const {return mSize == 0;};
+    size_t size() const {return mSize;};
+
+    void clear()
+    {
+        mHead = 0;
+        mSize = 0;
+    }
+
+    void push(const ValueType& value)
+    {
+        if(mSize == mBuffer.size())
+        {
+            grow();
+        }
+
+        //the capacity is a power of 2, so the index wraps around with a bitwise and
+        mBuffer[(mHead + mSize) & (mBuffer.size() - 1)] = value;
+        ++mSize;
+    }
+
+    ValueType pop()
+    {
+        ValueType result = mBuffer[mHead];
+        mHead = (mHead + 1) & (mBuffer.size() - 1);
+        --mSize;
+
+        return result;
+    }
+
+    private:
+    vector<ValueType> mBuffer;
+    //index of the front element
+    size_t mHead{0};
+    size_t mSize{0};
+
+    void grow()
+    {
+        vector<ValueType> newBuffer(mBuffer.empty() ? 16 : 2 * mBuffer.size());
+
+        //copy the elements in their queue order, so the front element is at index 0 in the new buffer
+        for(size_t idx{0}; idx < mSize; ++idx)
+        {
+            newBuffer[idx] = mBuffer[(mHead + idx) & (mBuffer.size() - 1)];
+        }
+
+        mBuffer = move(newBuffer);
+        mHead = 0;
+    }
+};
+
+/*
+* Level order (BFS) iterator: the nodes are visited level by level, from the root down, and from left to right on each level.
+* The nodes waiting to be visited are kept in a RingBuffer owned by a BasicLevelOrderTraversal, which outlives its iterators.
+* When a node is visited, its children are pushed to the queue. As the queue holds only nodes of the current level and of the
+* next one, the number of nodes of the current level left in queue tells when the next level starts.
+*
+* Besides the node, the iterator exposes the level of the node, the root being on level 0, and whether the node is the first
+* one on its level, so the level boundaries are known without computing the tree's height. Breaking out of the loop terminates
+* the traversal early, without visiting the remaining nodes.
+* As all the copies of an iterator share the same queue, it is an input iterator: the traversal can be performed only once.
+*/
+template<class Traits>
+class BasicLevelOrderIterator : private Traits
+{
+    public:
+    using handle_type = typename Traits::handle_type;
+    using iterator_category = input_iterator_tag;
+    using value_type = typename Traits::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    BasicLevelOrderIterator() = default;
+    BasicLevelOrderIterator(handle_type root, RingBuffer<handle_type>& queue, const Traits& traits = Traits{})
+    : Traits{traits}, current{root}, queue{&queue} {};
+
+    reference operator*() const {return Traits::get(current);};
+    pointer operator->() const {return &Traits::get(current);};
+    handle_type handle() const {return current;};
+
+    size_t level() const {return currentLevel;};
+    bool isLevelStart() const {return isFirstOnLevel;};
+
+    BasicLevelOrderIterator& operator++()
+    {
+        const handle_type left = Traits::left(current);
+        const handle_type right = Traits::right(current);
+
+        if(left != Traits::nullHandle)
+        {
+            queue->push(left);
+        }
+
+        if(right != Traits::nullHandle)
+        {
+            queue->push(right);
+        }
+
+        //when the current level is exhausted, all the nodes in queue belong to the next level
+        isFirstOnLevel = (nodesLeftOnLevel == 0);
+        if(isFirstOnLevel)
+        {
+            ++currentLevel;
+            nodesLeftOnLevel = queue->size();
+        }
+
+        if(queue->empty())
+        {
+            current = Traits::nullHandle;
+        }
+        else
+        {
+            current = queue->pop();
+            --nodesLeftOnLevel;
+        }
+
+        return *this;
+    }
+
+    friend bool operator==(const BasicLevelOrderIterator& lhs, const BasicLevelOrderIterator& rhs) {return lhs.current == rhs.current;};
+    friend bool operator!=(const BasicLevelOrderIterator& lhs, const BasicLevelOrderIterator& rhs) {return lhs.current != rhs.current;};
+
+    private:
+    handle_type current{Traits::nullHandle};
+    RingBuffer<handle_type>* queue{nullptr};
+    size_t currentLevel{0};
+    //the root is the only node on level 0, so no other node of its level is left
+    size_t nodesLeftOnLevel{0};
+    bool isFirstOnLevel{true};
+};
+
+template<class T>
+using LevelOrderIterator = BasicLevelOrderIterator<NodePointerTraits<T>>;
+
+/*
+* Owns the queue used by level order iterators. The same instance can be used for several traversals, one at a time,
+* as each traversal clears the queue, but keeps its buffer, so the traversals following the first ones do not allocate.
+*/
+template<class Traits>
+class BasicLevelOrderTraversal
+{
+    public:
+    using handle_type = typename Traits::handle_type;
+    using iterator = BasicLevelOrderIterator<Traits>;
+
+    BasicLevelOrderTraversal(const Traits& traits = Traits{}) : mTraits{traits} {};
+
+    TraversalRange<iterator> traverse(handle_type root)
+    {
+        mQueue.clear();
+
+        return {iterator{root, mQueue, mTraits}, iterator{}};
+    }
+
+    private:
+    Traits mTraits;
+    RingBuffer<handle_type> mQueue;
+};
\ No newline at end of file
@@ -5,6 +5,16 @@
 #include <queue>
 using namespace std;
 
+//defined in NodeIterators.hpp, used by BFS and BFSWithQueue
+template <class T>
+struct NodePointerTraits;
+
+template <class Traits>
+class BasicLevelOrderTraversal;
+
+template <class T>
+using LevelOrderTraversal = BasicLevelOrderTraversal<NodePointerTraits<T>>;
+
 template <class T>
 struct Node
 {
@@ -176,44 +186,34 @@ struct Node
         }
     }
 
+    /*
+    * Calling currentLevelBFS for each level walks the tree again from the root, for each level, which costs O(n*height).
+    * Instead, the level order traversal visits each node once, keeping the nodes of the next level in a queue.
+    */
     friend void BFS(Node<T>* startNode)
     {
-        auto height = treeHeight(startNode);
+        LevelOrderTraversal<T> traversal{};
 
-        //loop which tell the function how many levels it should go down in the tree
-        for(size_t idx{1}; idx <= height; ++idx)
+        for(Node<T>& node : traversal.traverse(startNode))
         {
-            currentLevelBFS(startNode, idx);
+            cout<< node.value <<" ";
         }
     }
 
+    /*
+    * Appends the nodes to result, in level order. The traversal is performed by LevelOrderTraversal, which can be used
+    * directly in order to process the nodes as they are visited, without collecting them in a vector.
+    */
     void BFSWithQueue(Node<T>* startNode, vector<Node<T>*>& result)
     {
-        queue<Node<T>*> levelNodes;
+        LevelOrderTraversal<T> traversal{};
 
-        if(result.empty())
+        for(Node<T>& node : traversal.traverse(startNode))
         {
-            result.push_back(startNode);
-            levelNodes.push(startNode);
-        }
-        
-        while(!levelNodes.empty())
-        {
-            //take the front node in queue, pop it then go down further in tree from it
-            Node<T>* currentNode = levelNodes.front();
-            levelNodes.pop();
-
-            if(currentNode->left)
-            {
-                levelNodes.push(currentNode->left);
-                result.push_back(currentNode->left);
-            }
-
-            if(currentNode->right)
-            {
-                levelNodes.push(currentNode->right);
-                result.push_back(currentNode->right);
-            }
+            result.push_back(&node);
         }
     }
-};
\ No newline at end of file
+};
+
+//the level order traversal used above is defined along with the other iterators
+#include "NodeIterators.hpp"
\ No newline at end of file
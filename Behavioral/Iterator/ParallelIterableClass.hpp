@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "IterableClass.hpp"
+#include "WorkStealingPool.hpp"
+
+/*
+* Parallel iteration over the elements of an IterableClass, which are split in chunks processed as tasks of a WorkStealingPool.
+*
+* The size of the chunks is chosen so that there are about 8 chunks per thread, for the pool to balance the work if some elements
+* take longer than others, but a chunk is never smaller than 16KB, so the cost of a task stays small compared to the work it does.
+* The chunks start at cache line boundaries: a cache line is never written by 2 threads, which would make it bounce between their
+* cores (false sharing). If the size of the elements does not divide the cache line size, an element may straddle 2 chunks'
+* boundary, so the chunk starts with the first element beginning after the boundary.
+*
+* The function is called concurrently for elements of different chunks, so it must not modify shared state without synchronization.
+*/
+namespace ParallelIterationDetails
+{
+    constexpr size_t cacheLineSize{64};
+    constexpr size_t minChunkBytes{16 * 1024};
+    constexpr size_t chunksPerThread{8};
+
+    //returns the indices of the first element of each chunk, followed by count
+    template<class T>
+    vector<size_t> getChunksBoundaries(const T* first, const size_t count, const size_t threadsCount)
+    {
+        const size_t targetChunkBytes = max(minChunkBytes, count * sizeof(T) / (threadsCount * chunksPerThread));
+        //the chunk size in bytes is a multiple of the cache line size, so the boundaries are aligned
+        const size_t chunkBytes = (targetChunkBytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+        const uintptr_t firstAddress = reinterpret_cast<uintptr_t>(first);
+        //the first chunk ends at a cache line boundary, so it may be shorter than the next ones
+        const uintptr_t firstAlignedAddress = (firstAddress + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+
+        vector<size_t> boundaries{0};
+
+        for(uintptr_t boundaryAddress{firstAlignedAddress + chunkBytes}; ; boundaryAddress += chunkBytes)
+        {
+            //the first element beginning at or after the boundary
+            const size_t boundary = (boundaryAddress - firstAddress + sizeof(T) - 1) / sizeof(T);
+
+            if(boundary >= count)
+            {
+                break;
+            }
+
+            boundaries.push_back(boundary);
+        }
+
+        boundaries.push_back(count);
+
+        return boundaries;
+    }
+
+    //partial results are padded to a cache line each, so that the threads writing them do not share cache lines
+    template<class ResultType>
+    struct alignas(cacheLineSize) PartialResult
+    {
+        ResultType value;
+    };
+}
+
+//calls function(element) for each element in [first, first + count), on the threads of the pool
+template<class T, class Function>
+void parallel_for_each(WorkStealingPool& pool, T* first, const size_t count, const Function& function)
+{
+    const vector<size_t> boundaries = ParallelIterationDetails::getChunksBoundaries(first, count, pool.getThreadsCount());
+    WorkStealingPool::TaskGroup group{pool};
+
+    for(size_t chunkIdx{0}; chunkIdx + 1 < boundaries.size(); ++chunkIdx)
+    {
+        group.run([chunkFirst = first + boundaries[chunkIdx], chunkLast = first + boundaries[chunkIdx + 1], &function]()
+        {
+            for_each(chunkFirst, chunkLast, function);
+        });
+    }
+
+    group.wait();
+}
+
+template<class T, class Allocator, size_t InlineCapacity, class Function>
+void parallel_for_each(WorkStealingPool& pool, IterableClass<T, Allocator, InlineCapacity>& iterable, const Function& function)
+{
+    parallel_for_each(pool, iterable.data(), iterable.size(), function);
+}
+
+/*
+* Transforms each element, then combines the results by reduce, starting from init: each chunk is reduced on its own, from its
+* first transformed element, then init and the results of the chunks are reduced in the order of the chunks. Thus, init is used
+* exactly once, as for std::transform_reduce, and is returned for no elements. reduce must be associative, but it does not need
+* to be commutative.
+*/
+template<class T, class ResultType, class ReduceFunction, class TransformFunction>
+ResultType parallel_transform_reduce(WorkStealingPool& pool, const T* first, const size_t count, const ResultType& init,
+                                     const ReduceFunction& reduce, const TransformFunction& transform)
+{
+    using ParallelIterationDetails::PartialResult;
+
+    const vector<size_t> boundaries = ParallelIterationDetails::getChunksBoundaries(first, count, pool.getThreadsCount());
+    //init only fills the slots, each task overwrites its slot with the first transformed element of its chunk
+    vector<PartialResult<ResultType>> partialResults(boundaries.size() - 1, PartialResult<ResultType>{init});
+
+    {
+        WorkStealingPool::TaskGroup group{pool};
+
+        for(size_t chunkIdx{0}; chunkIdx + 1 < boundaries.size(); ++chunkIdx)
+        {
+            //a chunk is empty when there are no elements, or when an element is larger than the chunk size
+            if(boundaries[chunkIdx] == boundaries[chunkIdx + 1])
+            {
+                continue;
+            }
+
+            group.run([chunkFirst = first + boundaries[chunkIdx], chunkLast = first + boundaries[chunkIdx + 1],
+                       &result = partialResults[chunkIdx].value, &reduce, &transform]()
+            {
+                result = transform(*chunkFirst);
+
+                for(const T* element{chunkFirst + 1}; element != chunkLast; ++element)
+                {
+                    result = reduce(result, transform(*element));
+                }
+            });
+        }
+
+        group.wait();
+    }
+
+    ResultType result{init};
+    for(size_t chunkIdx{0}; chunkIdx + 1 < boundaries.size(); ++chunkIdx)
+    {
+        if(boundaries[chunkIdx] != boundaries[chunkIdx + 1])
+        {
+            result = reduce(result, partialResults[chunkIdx].value);
+        }
+    }
+
+    return result;
+}
+
+template<class T, class Allocator, size_t InlineCapacity, class ResultType, class ReduceFunction, class TransformFunction>
+ResultType parallel_transform_reduce(WorkStealingPool& pool, const IterableClass<T, Allocator, InlineCapacity>& iterable,
+                                     const ResultType& init, const ReduceFunction& reduce, const TransformFunction& transform)
+{
+    return parallel_transform_reduce(pool, iterable.data(), iterable.size(), init, reduce, transform);
+}
+
+//reduces the elements themselves, e.g. parallel_reduce(pool, iterable, 0, plus<>{}) sums them
+template<class T, class Allocator, size_t InlineCapacity, class ResultType, class ReduceFunction>
+ResultType parallel_reduce(WorkStealingPool& pool, const IterableClass<T, Allocator, InlineCapacity>& iterable, const ResultType& init,
+                           const ReduceFunction& reduce)
+{
+    return parallel_transform_reduce(pool, iterable.data(), iterable.size(), init, reduce, [](const T& element) -> const T& {return element;});
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "NodeTraversals.hpp"
+#include "NodeIterators.hpp"
+#include "WorkStealingPool.hpp"
+
+/*
+* Parallel traversals of the nodes of a tree, which split the work at subtrees: whenever a node has 2 children, its right subtree
+* becomes a task of the WorkStealingPool, whilst the current thread goes on with the left one, then combines both results.
+* The chains of nodes having a single child are walked by loops, so they neither fork, nor recurse, however deep the tree is.
+* Forking stops after a number of levels of forks, depending on the threads count, so there are enough tasks to balance the
+* work between threads, but not so many that their overhead matters. The subtrees left are traversed sequentially, by the iterators.
+*
+* The results are combined in preorder: the result of a node, then the one of its left subtree, then the one of its right subtree.
+* Thus the reduce operation only needs to be associative, not commutative. The tree must not be modified during a traversal.
+*/
+namespace ParallelTraversalDetails
+{
+    //8 forks per thread if the tree is balanced, so an idle thread has bigger tasks to steal than just the last ones
+    inline size_t getForksDepth(const WorkStealingPool& pool)
+    {
+        size_t depth{3};
+
+        for(size_t threads{pool.getThreadsCount()}; threads > 1; threads = (threads + 1) / 2)
+        {
+            ++depth;
+        }
+
+        return depth;
+    }
+
+    template<class T, class ResultType, class MapFunction, class ReduceFunction>
+    ResultType reduceSubtree(WorkStealingPool& pool, Node<T>* node, const size_t forksLeft, const ResultType& identity,
+                             const MapFunction& map, const ReduceFunction& reduce)
+    {
+        ResultType result{identity};
+
+        while(node)
+        {
+            if(forksLeft == 0)
+            {
+                for(Node<T>& subtreeNode : preorderRange(node))
+                {
+                    result = reduce(result, map(subtreeNode));
+                }
+
+                return result;
+            }
+
+            result = reduce(result, map(*node));
+
+            if(node->left && node->right)
+            {
+                ResultType rightResult{identity};
+                WorkStealingPool::TaskGroup group{pool};
+                group.run([&pool, &rightResult, right = node->right, forksLeft, &identity, &map, &reduce]()
+                {
+                    rightResult = reduceSubtree(pool, right, forksLeft - 1, identity, map, reduce);
+                });
+
+                ResultType leftResult = reduceSubtree(pool, node->left, forksLeft - 1, identity, map, reduce);
+                group.wait();
+
+                return reduce(reduce(result, leftResult), rightResult);
+            }
+
+            node = node->left ? node->left : node->right;
+        }
+
+        return result;
+    }
+
+    /*
+    * A node found in a subtree is the first one in preorder if it is not preceded by a node found in the subtree of a left sibling
+    * of one of its ancestors. The search of a right subtree is given the flags set by the searches of those left subtrees, as a list,
+    * so it gives up as soon as it cannot find the first node anymore.
+    */
+    struct CancellationScope
+    {
+        const atomic<bool>& isFoundBefore;
+        const CancellationScope* outer;
+
+        bool isCancelled() const
+        {
+            for(const CancellationScope* scope{this}; scope; scope = scope->outer)
+            {
+                if(scope->isFoundBefore.load(memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    //checking the cancellation for each node would be costly, so it is checked once per batch of nodes
+    constexpr size_t cancellationCheckInterval{1024};
+
+    template<class T, class Predicate>
+    Node<T>* findFirstInSubtree(WorkStealingPool& pool, Node<T>* node, const size_t forksLeft, const Predicate& predicate,
+                                const CancellationScope* scope)
+    {
+        while(node)
+        {
+            if(scope && scope->isCancelled())
+            {
+                return nullptr;
+            }
+
+            if(forksLeft == 0)
+            {
+                size_t visitedNodes{0};
+
+                for(Node<T>& subtreeNode : preorderRange(node))
+                {
+                    if(predicate(subtreeNode))
+                    {
+                        return &subtreeNode;
+                    }
+
+                    if(++visitedNodes % cancellationCheckInterval == 0 && scope && scope->isCancelled())
+                    {
+                        return nullptr;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            if(predicate(*node))
+            {
+                return node;
+            }
+
+            if(node->left && node->right)
+            {
+                atomic<bool> isFoundInLeft{false};
+                const CancellationScope rightScope{isFoundInLeft, scope};
+                Node<T>* rightResult{nullptr};
+
+                WorkStealingPool::TaskGroup group{pool};
+                group.run([&pool, &rightResult, right = node->right, forksLeft, &predicate, &rightScope]()
+                {
+                    rightResult = findFirstInSubtree(pool, right, forksLeft - 1, predicate, &rightScope);
+                });
+
+                Node<T>* leftResult = findFirstInSubtree(pool, node->left, forksLeft - 1, predicate, scope);
+                if(leftResult)
+                {
+                    isFoundInLeft.store(true, memory_order_relaxed);
+                }
+                group.wait();
+
+                return leftResult ? leftResult : rightResult;
+            }
+
+            node = node->left ? node->left : node->right;
+        }
+
+        return nullptr;
+    }
+
+    //height of a subtree, the nodes without children having height 1, as computed by treeHeight
+    template<class T>
+    size_t subtreeHeight(WorkStealingPool& pool, Node<T>* node, const size_t forksLeft)
+    {
+        size_t chainLength{0};
+
+        while(node)
+        {
+            if(forksLeft == 0)
+            {
+                //the level order traversal tells the level of each node, so the height is the level of the last one
+                thread_local LevelOrderTraversal<T> traversal{};
+                size_t lastLevel{0};
+
+                for(auto it = traversal.traverse(node).begin(); it != LevelOrderIterator<T>{}; ++it)
+                {
+                    lastLevel = it.level();
+                }
+
+                return chainLength + lastLevel + 1;
+            }
+
+            ++chainLength;
+
+            if(node->left && node->right)
+            {
+                size_t rightHeight{0};
+                WorkStealingPool::TaskGroup group{pool};
+                group.run([&pool, &rightHeight, right = node->right, forksLeft]()
+                {
+                    rightHeight = subtreeHeight(pool, right, forksLeft - 1);
+                });
+
+                const size_t leftHeight = subtreeHeight(pool, node->left, forksLeft - 1);
+                group.wait();
+
+                return chainLength + max(leftHeight, rightHeight);
+            }
+
+            node = node->left ? node->left : node->right;
+        }
+
+        return chainLength;
+    }
+}
+
+/*
+* Map/reduce over the nodes of the tree rooted in root: map is called for each node and its results are combined by reduce,
+* starting from identity, which must be the neutral element of reduce, e.g. 0 for a sum. Both functions are called concurrently.
+*/
+template<class T, class ResultType, class MapFunction, class ReduceFunction>
+ResultType parallelMapReduce(WorkStealingPool& pool, Node<T>* root, const ResultType& identity, const MapFunction& map,
+                             const ReduceFunction& reduce)
+{
+    return ParallelTraversalDetails::reduceSubtree(pool, root, ParallelTraversalDetails::getForksDepth(pool), identity, map, reduce);
+}
+
+//calls function for each node, concurrently and in no particular order
+template<class T, class Function>
+void parallelForEach(WorkStealingPool& pool, Node<T>* root, const Function& function)
+{
+    struct Nothing {};
+
+    parallelMapReduce(pool, root, Nothing{}, [&function](Node<T>& node){function(node); return Nothing{};},
+                      [](Nothing, Nothing){return Nothing{};});
+}
+
+template<class T>
+T parallelSum(WorkStealingPool& pool, Node<T>* root)
+{
+    return parallelMapReduce(pool, root, T{}, [](const Node<T>& node){return node.value;}, plus<T>{});
+}
+
+template<class T>
+size_t parallelCount(WorkStealingPool& pool, Node<T>* root)
+{
+    return parallelMapReduce(pool, root, size_t{0}, [](const Node<T>&){return size_t{1};}, plus<size_t>{});
+}
+
+template<class T, class Predicate>
+size_t parallelCountIf(WorkStealingPool& pool, Node<T>* root, const Predicate& predicate)
+{
+    return parallelMapReduce(pool, root, size_t{0}, [&predicate](const Node<T>& node){return predicate(node) ? size_t{1} : size_t{0};},
+                             plus<size_t>{});
+}
+
+/*
+* Returns the first node in preorder for which predicate is true, or nullptr if there is none: the same node as a sequential
+* search would find. The searches of the subtrees following a subtree where a node was found are abandoned early.
+*/
+template<class T, class Predicate>
+Node<T>* parallelFindFirst(WorkStealingPool& pool, Node<T>* root, const Predicate& predicate)
+{
+    return ParallelTraversalDetails::findFirstInSubtree(pool, root, ParallelTraversalDetails::getForksDepth(pool), predicate, nullptr);
+}
+
+//same result as treeHeight, without recursing once per level, so it also works for trees too deep for treeHeight
+template<class T>
+size_t parallelTreeHeight(WorkStealingPool& pool, Node<T>* root)
+{
+    return ParallelTraversalDetails::subtreeHeight(pool, root, ParallelTraversalDetails::getForksDepth(pool));
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/*
+* Pool of threads executing fork-join tasks. Each worker thread owns a deque of tasks: the tasks it creates are pushed to the
+* back of its own deque and it takes its next task from the back as well, so it continues with the most recent, smallest task,
+* whose data is likely still in its cache. When its deque is empty, a worker steals a task from the front of another deque,
+* which holds the oldest, thus largest, task of that worker. Hence, the work is balanced without a central queue that all
+* threads contend on, even when the tasks have very different sizes, as the subtrees of an unbalanced tree do.
+*
+* The tasks are run through a TaskGroup, whose wait method does not block the calling thread: it executes pending tasks
+* till the tasks of the group are done. Thus, tasks can fork and wait for subtasks without exhausting the threads of the pool.
+* Threads not belonging to the pool, such as the main thread, push their tasks to a shared deque and help as well whilst waiting.
+*/
+class WorkStealingPool
+{
+    public:
+    //the calling thread also runs tasks whilst waiting, so threadsCount-1 worker threads are created
+    explicit WorkStealingPool(const size_t threadsCount = thread::hardware_concurrency()) : threadsCount{max<size_t>(1, threadsCount)}
+    {
+        //the deque at index 0 is shared by the threads outside the pool
+        for(size_t idx{0}; idx < this->threadsCount; ++idx)
+        {
+            queues.push_back(make_unique<TaskQueue>());
+        }
+
+        for(size_t idx{1}; idx < this->threadsCount; ++idx)
+        {
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, idx);
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool()
+    {
+        {
+            lock_guard<mutex> lock{sleepMutex};
+            stopping = true;
+        }
+        wakeUp.notify_all();
+
+        for(thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    size_t getThreadsCount() const {return threadsCount;};
+
+    /*
+    * Tracks the tasks it runs, so they can be waited for. The first exception thrown by a task is rethrown by wait.
+    * The group must be waited for before it is destroyed, which the destructor does, if it was not done before.
+    */
+    class TaskGroup
+    {
+        public:
+        explicit TaskGroup(WorkStealingPool& pool) : pool{pool} {};
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        ~TaskGroup()
+        {
+            while(pendingTasks.load(memory_order_acquire) > 0)
+            {
+                helpOrYield();
+            }
+        }
+
+        void run(function<void()> task)
+        {
+            pendingTasks.fetch_add(1, memory_order_relaxed);
+
+            pool.push([this, task = move(task)]()
+            {
+                try
+                {
+                    task();
+                }
+                catch(...)
+                {
+                    lock_guard<mutex> lock{exceptionMutex};
+                    if(!exception)
+                    {
+                        exception = current_exception();
+                    }
+                }
+
+                pendingTasks.fetch_sub(1, memory_order_release);
+            });
+        }
+
+        void wait()
+        {
+            while(pendingTasks.load(memory_order_acquire) > 0)
+            {
+                helpOrYield();
+            }
+
+            if(exception)
+            {
+                rethrow_exception(exchange(exception, nullptr));
+            }
+        }
+
+        private:
+        WorkStealingPool& pool;
+        atomic<size_t> pendingTasks{0};
+        mutex exceptionMutex;
+        exception_ptr exception;
+
+        //instead of blocking, the waiting thread runs a task, which may belong to this group or to any other one
+        void helpOrYield()
+        {
+            if(!pool.tryRunTask(pool.getCurrentQueueIndex()))
+            {
+                this_thread::yield();
+            }
+        }
+    };
+
+    private:
+    struct TaskQueue
+    {
+        mutex queueMutex;
+        deque<function<void()>> tasks;
+    };
+
+    size_t threadsCount;
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+
+    //the idle workers sleep till tasks are pushed
+    mutex sleepMutex;
+    condition_variable wakeUp;
+    atomic<size_t> queuedTasks{0};
+    bool stopping{false};
+
+    /*
+    * The index of the deque owned by the current thread, if it is a worker of this pool, otherwise 0.
+    * A thread may use several pools, so the pool it works for is kept along with the index.
+    */
+    struct WorkerIdentity
+    {
+        const WorkStealingPool* pool{nullptr};
+        size_t queueIndex{0};
+    };
+
+    static WorkerIdentity& getWorkerIdentity()
+    {
+        thread_local WorkerIdentity identity{};
+        return identity;
+    }
+
+    size_t getCurrentQueueIndex() const
+    {
+        const WorkerIdentity& identity = getWorkerIdentity();
+        return identity.pool == this ? identity.queueIndex : 0;
+    }
+
+    void push(function<void()> task)
+    {
+        /*
+        * The counter is changed under the lock of the sleeping workers, so none of them misses the notification. It is increased
+        * before the task is queued, so it is never lower than the number of queued tasks, even when the task is taken right away.
+        */
+        {
+            lock_guard<mutex> lock{sleepMutex};
+            queuedTasks.fetch_add(1, memory_order_relaxed);
+        }
+
+        TaskQueue& queue = *queues[getCurrentQueueIndex()];
+        {
+            lock_guard<mutex> lock{queue.queueMutex};
+            queue.tasks.push_back(move(task));
+        }
+
+        wakeUp.notify_one();
+    }
+
+    //takes a task from the back of the own deque, otherwise steals one from the front of another deque
+    bool tryRunTask(const size_t ownQueueIndex)
+    {
+        function<void()> task;
+
+        for(size_t offset{0}; offset < queues.size() && !task; ++offset)
+        {
+            TaskQueue& queue = *queues[(ownQueueIndex + offset) % queues.size()];
+            lock_guard<mutex> lock{queue.queueMutex};
+
+            if(queue.tasks.empty())
+            {
+                continue;
+            }
+
+            if(offset == 0)
+            {
+                task = move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+
+        if(!task)
+        {
+            return false;
+        }
+
+        queuedTasks.fetch_sub(1, memory_order_relaxed);
+        task();
+
+        return true;
+    }
+
+    void workerLoop(const size_t queueIndex)
+    {
+        getWorkerIdentity() = WorkerIdentity{this, queueIndex};
+
+        while(true)
+        {
+            if(tryRunTask(queueIndex))
+            {
+                continue;
+            }
+
+            unique_lock<mutex> lock{sleepMutex};
+            wakeUp.wait(lock, [this](){return stopping || queuedTasks.load(memory_order_relaxed) > 0;});
+
+            if(stopping)
+            {
+                return;
+            }
+        }
+    }
+};
\ No newline at end of file
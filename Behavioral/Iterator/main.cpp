@@ -1,6 +1,14 @@
 #include "NodeTraversals.hpp"
+#include "NodeIterators.hpp"
+#include "NodeArena.hpp"
+#include "ParallelNodeTraversals.hpp"
+#include "FrozenTree.hpp"
 #include "IterableClass.hpp"
+#include "ParallelIterableClass.hpp"
+#include <any>
 #include <string>
+#include <numeric>
+#include <memory_resource>
 
 
 /*
@@ -31,7 +39,7 @@ int main()
     cout<<endl<<"classic binary tree recursive preorder traversal "<<endl;
     classicPreOrderTraversal(&root);
 
-    cout<<endl<<"binary tree recursive preorder traversal with nodes being pushed to input vector "<<endl;
+    cout<<endl<<"binary tree preorder traversal with nodes being pushed to input vector "<<endl;
     vector<Node<string>*> result;
     root.preorderTraversal(result);
     for(Node<string>* n : result)
@@ -42,7 +50,7 @@ int main()
     cout<<endl<<"classic binary tree recursive postorder traversal "<<endl;
     classicPostOrderTraversal(&root);
 
-    cout<<endl<<"binary tree recursive postorder traversal with nodes being pushed to input vector "<<endl;
+    cout<<endl<<"binary tree postorder traversal with nodes being pushed to input vector "<<endl;
     vector<Node<string>*> result2;
     root.postorderTraversal(result2);
     for(Node<string>* n : result2)
@@ -53,7 +61,7 @@ int main()
     cout<<endl<<"classic binary tree recursive inorder traversal "<<endl;
     classicInOrderTraversal(&root);
 
-    cout<<endl<<"binary tree recursive inorder traversal with nodes being pushed to input vector "<<endl;
+    cout<<endl<<"binary tree inorder traversal with nodes being pushed to input vector "<<endl;
     vector<Node<string>*> result3;
     root.inorderTraversal(result3);
     for(Node<string>* n : result3)
@@ -61,6 +69,65 @@ int main()
         cout<< n->value << " ";
     }
 
+    cout<<endl<<"lazy preorder, inorder and postorder traversals with iterators "<<endl;
+    for(Node<string>& n : preorderRange(&root))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    for(Node<string>& n : inorderRange(&root))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    //traversal of the subtree rooted in D
+    for(Node<string>& n : postorderRange(&n3))
+    {
+        cout<< n.value << " ";
+    }
+
+    //a degenerated tree, which is a list of 1 million nodes, is too deep for the recursive traversals, but not for the iterators
+    vector<Node<int>> deepTree{};
+    deepTree.reserve(1000000);
+    deepTree.emplace_back(0);
+    for(int idx{1}; idx < 1000000; ++idx)
+    {
+        deepTree.emplace_back(idx);
+        deepTree[idx-1].setAsLeftNode(&deepTree[idx]);
+    }
+
+    long long sumOfValues{0};
+    for(Node<int>& n : postorderRange(&deepTree[0]))
+    {
+        sumOfValues += n.value;
+    }
+    cout<<endl<<"sum of the values in a tree 1 million nodes deep: "<<sumOfValues;
+
+    //a complete binary tree of 1 million nodes, where the children of the node at idx are at 2*idx+1 and 2*idx+2
+    vector<Node<int>> wideTree{};
+    wideTree.reserve(1000000);
+    wideTree.emplace_back(0);
+    for(int idx{1}; idx < 1000000; ++idx)
+    {
+        wideTree.emplace_back(idx % 10);
+        if(idx % 2)
+        {
+            wideTree[(idx-1)/2].setAsLeftNode(&wideTree[idx]);
+        }
+        else
+        {
+            wideTree[(idx-1)/2].setAsRightNode(&wideTree[idx]);
+        }
+    }
+
+    WorkStealingPool pool{};
+    cout<<endl<<"parallel traversals on "<<pool.getThreadsCount()<<" threads: sum "<<parallelSum(pool, &wideTree[0])
+        <<", nodes count "<<parallelCount(pool, &wideTree[0])<<", height "<<parallelTreeHeight(pool, &wideTree[0])
+        <<", height of the deep tree "<<parallelTreeHeight(pool, &deepTree[0]);
+
+    Node<int>* firstNine = parallelFindFirst(pool, &wideTree[0], [](const Node<int>& node){return node.value == 9;});
+    cout<<endl<<"first node in preorder with value 9 is at index "<<(firstNine - &wideTree[0]);
+
     cout<<endl<<" BFS output "<<endl;
     BFS(&root);
 
@@ -72,6 +139,87 @@ int main()
         cout<< n->value << " ";
     }
 
+    cout<<endl<<" BFS with level order iterator, printing each level on its own line, till the level of G"<<endl;
+    LevelOrderTraversal<string> levelOrder{};
+    for(auto it = levelOrder.traverse(&root).begin(); it != LevelOrderIterator<string>{}; ++it)
+    {
+        if(it.isLevelStart())
+        {
+            cout<<endl<<"level "<<it.level()<<": ";
+        }
+
+        cout<< it->value << " ";
+
+        //stop the traversal early
+        if(it->value == "G")
+        {
+            break;
+        }
+    }
+
+    cout<<endl<<" the same tree stored in a NodeArena, traversed by the same iterators "<<endl;
+    NodeArena<string> arena{};
+    arena.reserve(11);
+    //a node is attached to its parent as left child, or as right child if the left one is already set
+    auto a = arena.allocate("A");
+    auto b = arena.allocate("B", a);
+    auto c = arena.allocate("C", a);
+    auto d = arena.allocate("D", b);
+    arena.allocate("E", b);
+    arena.allocate("F", c);
+    arena.allocate("J", d);
+    auto g = arena.allocate("G", d);
+    auto h = arena.allocate("H", g);
+    arena.allocate("K", g);
+    arena.setAsRightNode(h, arena.allocate("I"));
+
+    for(auto& n : preorderRange(arena, a))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    for(auto& n : inorderRange(arena, a))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    for(auto& n : postorderRange(arena, a))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    ArenaLevelOrderTraversal<string> arenaLevelOrder{arena};
+    for(auto& n : arenaLevelOrder.traverse(a))
+    {
+        cout<< n.value << " ";
+    }
+
+    //all the nodes are freed at once, whilst the blocks are kept for the next tree
+    arena.clear();
+
+    cout<<endl<<" the same tree frozen in preorder layout: same shape, so same inorder, preorder and postorder sequences"<<endl;
+    FrozenTree<string> frozenTree{&root};
+    for(auto& n : inorderRange(frozenTree))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    for(auto& n : preorderRange(frozenTree))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    for(auto& n : postorderRange(frozenTree))
+    {
+        cout<< n.value << " ";
+    }
+    cout<<endl;
+    //the preorder is the order of the array
+    for(auto& n : frozenTree)
+    {
+        cout<< n.value << " ";
+    }
+
 
 
     cout<<endl<<" IterableClass and IteratorClass"<<endl;
@@ -102,5 +250,59 @@ int main()
     for(IterableClass<int>::iterator iter{intBuffer.begin()}; iter != intBuffer.end(); ++iter)
         cout<<*iter<<" ";
 
+    //the iterators are random access and dereference to references, so std algorithms sort the elements in place
+    sort(intBuffer.begin(), intBuffer.end());
+    cout<<endl<<"sorted, in reverse order: ";
+    for(auto rit = intBuffer.rbegin(); rit != intBuffer.rend(); ++rit)
+        cout<<*rit<<" ";
+    cout<<", 6 is at index "<<(lower_bound(intBuffer.cbegin(), intBuffer.cend(), 6) - intBuffer.cbegin());
+
+    //elements are constructed in place, in a buffer whose capacity doubles when full
+    IterableClass<string> strings{};
+    strings.reserve(2);
+    strings.emplace_back("first");
+    strings.emplace_back(3, 'x');
+    strings.push_back("third");
+    cout<<endl<<"size "<<strings.size()<<", capacity "<<strings.capacity()<<": ";
+    for(const string& elem : strings)
+        cout<<elem<<" ";
+
+    strings.shrink_to_fit();
+    cout<<endl<<"capacity after shrink_to_fit "<<strings.capacity()<<endl;
+
+    /*
+    * Up to 16 ints are stored inline, in the object itself, without any allocation. Beyond that, the memory is taken from
+    * a monotonic arena, which only bumps a pointer into a local buffer, and releases it all at once, when destroyed.
+    */
+    char arenaBuffer[4096];
+    pmr::monotonic_buffer_resource arenaResource{arenaBuffer, sizeof(arenaBuffer)};
+    using ArenaIterableClass = IterableClass<int, pmr::polymorphic_allocator<int>>;
+
+    ArenaIterableClass shortBuffer{{1, 2, 3}, &arenaResource};
+    ArenaIterableClass longBuffer{&arenaResource};
+    for(int idx{0}; idx < 100; ++idx)
+    {
+        longBuffer.push_back(idx);
+    }
+    cout<<"short collection is inline: "<<boolalpha<<shortBuffer.isSmall()<<", long collection is inline: "<<longBuffer.isSmall()
+        <<", sum of long collection "<<accumulate(longBuffer.begin(), longBuffer.end(), 0)<<endl;
+
+    //std::any can be constructed from an allocator, so a copy must not be mistaken for a list holding the allocator
+    IterableClass<any> anyBuffer{any{1}, any{string{"two"}}}, anyCopy{};
+    anyCopy = anyBuffer;
+    cout<<"copy of "<<anyBuffer.size()<<" std::any holds "<<anyCopy.size()<<" elements, the second one being "
+        <<any_cast<const string&>(anyCopy[1])<<endl;
+
+    //the elements are processed in chunks starting at cache line boundaries, on the threads of the pool used for the trees
+    IterableClass<double> samples{};
+    samples.reserve(1000000);
+    for(int idx{0}; idx < 1000000; ++idx)
+    {
+        samples.push_back(idx % 100);
+    }
+    parallel_for_each(pool, samples, [](double& sample){sample = sample * sample;});
+    cout<<"parallel sum of squares "<<parallel_reduce(pool, samples, 0.0, plus<double>{})
+        <<", maximum "<<parallel_reduce(pool, samples, 0.0, [](double lhs, double rhs){return max(lhs, rhs);})<<endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+//observer headers
+#include "Observer.hpp"
+#include "Observable.hpp"
+
+//what NotifyAll does when the queue of a worker is full
+enum class OverflowPolicy
+{
+    Block,          //back-pressure: the notifying thread waits for the worker to make room
+    DropNewest,     //the new change is discarded
+    DropOldest,     //the oldest queued change is discarded, to make room for the new one
+    MergeWithLast   //the new change replaces the last queued one, as only the latest data matters
+};
+
+struct AsyncDeliveryOptions
+{
+    size_t workersCount{1};
+    size_t queueCapacity{1024};
+    OverflowPolicy overflowPolicy{OverflowPolicy::Block};
+    //when a worker finds several changes queued, only the latest is delivered to all observers
+    bool coalesce{true};
+};
+
+/*
+* Observable whose notifications are delivered asynchronously, by worker threads, so a slow observer does not stall the threads
+* calling SetData and NotifyAll. The observers are spread over the workers, each owning a bounded queue of changes, to which
+* NotifyAll appends the current data, thus the queues have multiple producers and a single consumer. A worker wakes up when
+* changes are queued, takes all of them at once, then delivers them to its observers, in the order they were queued. If coalesce
+* is set, only the latest of the changes taken at once is delivered to all observers, as the intermediate ones are outdated:
+* the slower the observers, the more changes are merged. When a queue is full, the overflow policy decides between blocking
+* the producer and dropping or merging changes (see OverflowPolicy), the dropped ones being counted.
+*
+* The observers still call GetData in ProcessChange, which, on a worker thread, returns the data of the change being delivered,
+* rather than the current one, which may have been set meanwhile. A worker delivers to its observers one at a time, so an observer
+* is never called concurrently with itself, yet the observers of different workers are called concurrently with each other.
+* Subscribe and Unsubscribe publish copy on write lists of observers, as in ConcurrentObservableClass, so they do not wait for
+* deliveries in progress. Flush waits till the changes queued so far are delivered, and the destructor delivers the remaining ones.
+* Observers must not throw, and must not call Flush, nor NotifyAll with the Block policy, as they would wait for their own worker.
+*/
+class AsyncObservableClass : public ObservableInterface<AsyncObservableClass, std::string>
+{
+    public:
+    using ObserverPtr = std::shared_ptr<ObserverInterface<AsyncObservableClass>>;
+    using ObserversList = std::vector<ObserverPtr>;
+
+    explicit AsyncObservableClass(const AsyncDeliveryOptions& options = AsyncDeliveryOptions{}):mOptions{options}
+    {
+        mOptions.workersCount = std::max<size_t>(mOptions.workersCount, 1);
+        mOptions.queueCapacity = std::max<size_t>(mOptions.queueCapacity, 1);
+
+        mWorkers.reserve(mOptions.workersCount);
+        for(size_t workerIdx{0}; workerIdx < mOptions.workersCount; ++workerIdx)
+        {
+            mWorkers.push_back(std::make_unique<Worker>(*this));
+        }
+    }
+
+    AsyncObservableClass(const AsyncObservableClass&) = delete;
+    AsyncObservableClass& operator=(const AsyncObservableClass&) = delete;
+
+    ~AsyncObservableClass()
+    {
+        //the workers deliver the queued changes before stopping
+        for(auto&& worker : mWorkers)
+        {
+            worker->Stop();
+        }
+    }
+
+    void SetData(const std::string& str)
+    {
+        std::atomic_store(&mData, std::make_shared<const std::string>(str));
+    }
+
+    std::string GetData() const
+    {
+        if(tDelivery.observable == this)
+        {
+            return *tDelivery.data;
+        }
+
+        return *std::atomic_load(&mData);
+    }
+
+    //waits till the changes queued before the call are delivered
+    void Flush()
+    {
+        for(auto&& worker : mWorkers)
+        {
+            worker->WaitIdle();
+        }
+    }
+
+    size_t GetDroppedCount() const {return mDroppedCount.load(std::memory_order_relaxed);};
+
+    private:
+    //a change to deliver to all the observers of a worker, or only to target, if set
+    struct Change
+    {
+        std::shared_ptr<const std::string> data;
+        ObserverPtr target;
+    };
+
+    //the change a worker thread is delivering, returned by GetData
+    struct DeliveryContext
+    {
+        const AsyncObservableClass* observable{nullptr};
+        const std::string* data{nullptr};
+    };
+
+    class Worker
+    {
+        public:
+        explicit Worker(AsyncObservableClass& owner):mOwner{owner}, mQueue(owner.mOptions.queueCapacity)
+        {
+            mThread = std::thread{[this](){Run();}};
+        }
+
+        void Enqueue(Change&& change)
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+
+            if(mCount == mQueue.size())
+            {
+                switch(mOwner.mOptions.overflowPolicy)
+                {
+                    case OverflowPolicy::MergeWithLast:
+                        //a change targeting a single observer cannot be merged with a broadcast one, so it blocks
+                        if(!change.target && !mQueue[getIndex(mCount - 1)].target)
+                        {
+                            mQueue[getIndex(mCount - 1)].data = std::move(change.data);
+                            mOwner.mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                            return;
+                        }
+                        [[fallthrough]];
+                    case OverflowPolicy::Block:
+                        mNotFull.wait(lock, [this](){return mCount < mQueue.size() || mStopping;});
+                        if(mStopping)
+                        {
+                            mOwner.mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                            return;
+                        }
+                        break;
+                    case OverflowPolicy::DropNewest:
+                        mOwner.mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    case OverflowPolicy::DropOldest:
+                        mQueue[mHead] = Change{};
+                        mHead = getIndex(1);
+                        --mCount;
+                        mOwner.mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                }
+            }
+
+            mQueue[getIndex(mCount)] = std::move(change);
+            ++mCount;
+            lock.unlock();
+
+            mNotEmpty.notify_one();
+        }
+
+        void WaitIdle()
+        {
+            std::unique_lock<std::mutex> lock{mMutex};
+            mIdle.wait(lock, [this](){return mCount == 0 && !mDelivering;});
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock{mMutex};
+                mStopping = true;
+            }
+
+            mNotEmpty.notify_one();
+            mNotFull.notify_all();
+            mThread.join();
+        }
+
+        //the observers are only read by this worker's thread, but may be replaced by any thread, under the owner's writers mutex
+        std::shared_ptr<const ObserversList> mObservers{std::make_shared<const ObserversList>()};
+
+        private:
+        AsyncObservableClass& mOwner;
+        //ring buffer of mCount changes, starting at mHead
+        std::vector<Change> mQueue;
+        size_t mHead{0};
+        size_t mCount{0};
+        bool mDelivering{false};
+        bool mStopping{false};
+        std::mutex mMutex;
+        std::condition_variable mNotEmpty;
+        std::condition_variable mNotFull;
+        std::condition_variable mIdle;
+        std::thread mThread;
+
+        size_t getIndex(const size_t offset) const {return (mHead + offset) % mQueue.size();};
+
+        void Run()
+        {
+            std::vector<Change> batch;
+            batch.reserve(mQueue.size());
+
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mMutex};
+                    mNotEmpty.wait(lock, [this](){return mCount > 0 || mStopping;});
+
+                    if(mCount == 0)
+                    {
+                        break;
+                    }
+
+                    //the whole queue is taken at once, so the producers wait for the lock only once per batch
+                    for(; mCount > 0; --mCount)
+                    {
+                        batch.push_back(std::move(mQueue[mHead]));
+                        mHead = getIndex(1);
+                    }
+                    mDelivering = true;
+                }
+                mNotFull.notify_all();
+
+                Deliver(batch);
+                batch.clear();
+
+                {
+                    std::lock_guard<std::mutex> lock{mMutex};
+                    mDelivering = false;
+                }
+                mIdle.notify_all();
+            }
+
+            mIdle.notify_all();
+        }
+
+        void Deliver(const std::vector<Change>& batch)
+        {
+            const std::shared_ptr<const ObserversList> observers = std::atomic_load(&mObservers);
+            size_t lastBroadcastIdx{batch.size()};
+
+            if(mOwner.mOptions.coalesce)
+            {
+                for(size_t changeIdx{0}; changeIdx < batch.size(); ++changeIdx)
+                {
+                    lastBroadcastIdx = batch[changeIdx].target ? lastBroadcastIdx : changeIdx;
+                }
+            }
+
+            for(size_t changeIdx{0}; changeIdx < batch.size(); ++changeIdx)
+            {
+                const Change& change = batch[changeIdx];
+                tDelivery = DeliveryContext{&mOwner, change.data.get()};
+
+                if(change.target)
+                {
+                    change.target->ProcessChange(mOwner);
+                }
+                else if(!mOwner.mOptions.coalesce || changeIdx == lastBroadcastIdx)
+                {
+                    for(auto&& observer : *observers)
+                    {
+                        observer->ProcessChange(mOwner);
+                    }
+                }
+            }
+
+            tDelivery = DeliveryContext{};
+        }
+    };
+
+    void DoNotifyAll() override
+    {
+        const std::shared_ptr<const std::string> data = std::atomic_load(&mData);
+
+        for(auto&& worker : mWorkers)
+        {
+            worker->Enqueue(Change{data, nullptr});
+        }
+    }
+
+    //the change is delivered by the worker of the observer, so it is not called concurrently with itself
+    void DoNotifyOne(const ObserverPtr& observerObj) override
+    {
+        Worker* worker = FindWorker(observerObj);
+        (worker ? worker : mWorkers.front().get())->Enqueue(Change{std::atomic_load(&mData), observerObj});
+    }
+
+    //the new observer goes to the worker having the fewest observers
+    void DoSubscribe(const ObserverPtr& observerObj) override
+    {
+        std::lock_guard<std::mutex> lock{mWritersMutex};
+
+        if(FindWorker(observerObj))
+        {
+            return;
+        }
+
+        auto fewerObservers = [](const std::unique_ptr<Worker>& lhs, const std::unique_ptr<Worker>& rhs)
+        {
+            return std::atomic_load(&lhs->mObservers)->size() < std::atomic_load(&rhs->mObservers)->size();
+        };
+        Worker& worker = **std::min_element(mWorkers.begin(), mWorkers.end(), fewerObservers);
+        const std::shared_ptr<const ObserversList> observers = std::atomic_load(&worker.mObservers);
+
+        auto newObservers = std::make_shared<ObserversList>();
+        newObservers->reserve(observers->size() + 1);
+        *newObservers = *observers;
+        newObservers->push_back(observerObj);
+
+        std::atomic_store(&worker.mObservers, std::shared_ptr<const ObserversList>{std::move(newObservers)});
+    }
+
+    void DoUnsubscribe(const ObserverPtr& observerObj) override
+    {
+        std::lock_guard<std::mutex> lock{mWritersMutex};
+        Worker* worker = FindWorker(observerObj);
+
+        if(worker)
+        {
+            const std::shared_ptr<const ObserversList> observers = std::atomic_load(&worker->mObservers);
+
+            auto newObservers = std::make_shared<ObserversList>();
+            newObservers->reserve(observers->size() - 1);
+            std::remove_copy(observers->begin(), observers->end(), std::back_inserter(*newObservers), observerObj);
+
+            std::atomic_store(&worker->mObservers, std::shared_ptr<const ObserversList>{std::move(newObservers)});
+        }
+    }
+
+    Worker* FindWorker(const ObserverPtr& observerObj) const
+    {
+        for(auto&& worker : mWorkers)
+        {
+            const std::shared_ptr<const ObserversList> observers = std::atomic_load(&worker->mObservers);
+
+            if(std::find(observers->begin(), observers->end(), observerObj) != observers->end())
+            {
+                return worker.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    static thread_local DeliveryContext tDelivery;
+
+    AsyncDeliveryOptions mOptions;
+    std::shared_ptr<const std::string> mData{std::make_shared<const std::string>()};
+    std::atomic<size_t> mDroppedCount{0};
+    std::mutex mWritersMutex;
+    //declared last, so the workers stop before the other members are destroyed
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+};
+
+inline thread_local AsyncObservableClass::DeliveryContext AsyncObservableClass::tDelivery{};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+//observer headers
+#include "Observer.hpp"
+#include "Observable.hpp"
+
+/*
+* Observable which can be notified, subscribed to and unsubscribed from, by many threads at once.
+*
+* The observers list is copy on write: it is never modified once published, but replaced. Subscribe and Unsubscribe copy the
+* current list, modify the copy, then publish it by atomically storing the shared_ptr owning it. NotifyAll atomically loads the
+* shared_ptr, then iterates the list it points to, which stays alive and unchanged till the iteration ends, even if meanwhile it is
+* replaced, as the loaded shared_ptr keeps a reference to it. Thus, the notifying threads never wait for the subscribing ones
+* to update the list, nor for each other, and the observers unsubscribed during a notification may still receive it.
+* Only the writers are serialized by a mutex, so that 2 concurrent subscriptions do not both copy the same list and one of them is lost.
+*
+* This suits observables which are notified much more often than subscribed to, as each subscription copies the whole list.
+* The data is published the same way, so GetData returns the last value set, even while another thread sets a new one.
+* The atomic operations on shared_ptr are used via the C++11 free functions, which in some standard libraries are implemented
+* with a small pool of locks, held only for the time of copying the pointer, rather than for the time of a notification.
+*/
+class ConcurrentObservableClass : public ObservableInterface<ConcurrentObservableClass, std::string>
+{
+    public:
+    using ObserversList = std::vector<std::shared_ptr<ObserverInterface<ConcurrentObservableClass>>>;
+
+    void SetData(const std::string& str)
+    {
+        std::atomic_store(&mData, std::make_shared<const std::string>(str));
+    }
+
+    std::string GetData() const
+    {
+        return *std::atomic_load(&mData);
+    }
+
+    size_t GetObserversCount() const
+    {
+        return std::atomic_load(&mObserversList)->size();
+    }
+
+    private:
+    void DoNotifyAll() override
+    {
+        //the snapshot keeps the list alive, whatever the other threads publish meanwhile
+        const std::shared_ptr<const ObserversList> observersList = std::atomic_load(&mObserversList);
+
+        for(auto&& observer : *observersList)
+        {
+            observer->ProcessChange(*this);
+        }
+    }
+
+    void DoNotifyOne(const std::shared_ptr<ObserverInterface<ConcurrentObservableClass>>& observerObj) override
+    {
+        observerObj->ProcessChange(*this);
+    }
+
+    void DoSubscribe(const std::shared_ptr<ObserverInterface<ConcurrentObservableClass>>& observerObj) override
+    {
+        std::lock_guard<std::mutex> lock{mWritersMutex};
+        const std::shared_ptr<const ObserversList> observersList = std::atomic_load(&mObserversList);
+
+        if(std::find(observersList->begin(), observersList->end(), observerObj) == observersList->end())
+        {
+            auto newObserversList = std::make_shared<ObserversList>();
+            newObserversList->reserve(observersList->size() + 1);
+            *newObserversList = *observersList;
+            newObserversList->push_back(observerObj);
+
+            std::atomic_store(&mObserversList, std::shared_ptr<const ObserversList>{std::move(newObserversList)});
+        }
+    }
+
+    void DoUnsubscribe(const std::shared_ptr<ObserverInterface<ConcurrentObservableClass>>& observerObj) override
+    {
+        std::lock_guard<std::mutex> lock{mWritersMutex};
+        const std::shared_ptr<const ObserversList> observersList = std::atomic_load(&mObserversList);
+
+        if(std::find(observersList->begin(), observersList->end(), observerObj) != observersList->end())
+        {
+            auto newObserversList = std::make_shared<ObserversList>();
+            newObserversList->reserve(observersList->size() - 1);
+            std::remove_copy(observersList->begin(), observersList->end(), std::back_inserter(*newObserversList), observerObj);
+
+            std::atomic_store(&mObserversList, std::shared_ptr<const ObserversList>{std::move(newObserversList)});
+        }
+    }
+
+    std::shared_ptr<const std::string> mData{std::make_shared<const std::string>()};
+    std::shared_ptr<const ObserversList> mObserversList{std::make_shared<const ObserversList>()};
+    std::mutex mWritersMutex;
+};
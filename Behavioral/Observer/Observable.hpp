@@ -4,9 +4,11 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 
 //observer headers
 #include "Observer.hpp"
+#include "SlotMap.hpp"
 
 //Observed interface is a template whose type parameetrs include the Implementation class of this interface and the data type it works with
 //Exposes the required methods for add observer, remove observer, notify all observers, notify one observer, as wrappers of the private virtual methods
@@ -47,12 +49,48 @@ class ObservableInterface
 
 //The implementation of the above Observable interface, pivately implementing the inherited virtual methods 
 //Keeps a list of observers, as shared_ptr due to copies required by std::algorithms, whilst envisaging to keep the outside created instances
+//The observers are stored in a SlotMap, contiguously, so NotifyAll iterates them as fast as a vector, whilst Subscribe returns a handle
+//which unsubscribes the observer in O(1). Unsubscribing by shared_ptr is O(1) on average too, as the handles are also indexed by observer.
 class ObservableClass : public ObservableInterface<ObservableClass, std::string>
 {
     public:
+    using ObserverPtr = std::shared_ptr<ObserverInterface<ObservableClass>>;
+
     void SetData(const std::string& str){mData = str;};
     std::string GetData() const {return mData;};
-    
+
+    //subscribing an observer twice returns the handle of its first subscription
+    SlotHandle Subscribe(const ObserverPtr& observerObj)
+    {
+        return AddObserver(observerObj);
+    }
+
+    //returns false if the handle is stale, as its observer has already been unsubscribed
+    bool Unsubscribe(const SlotHandle handle)
+    {
+        const ObserverPtr* observerObj = mObserversList.get(handle);
+
+        if(!observerObj)
+        {
+            return false;
+        }
+
+        mHandles.erase(observerObj->get());
+        mObserversList.erase(handle);
+
+        return true;
+    }
+
+    using ObservableInterface<ObservableClass, std::string>::Unsubscribe;
+
+    void Reserve(const size_t observersCount)
+    {
+        mObserversList.reserve(observersCount);
+        mHandles.reserve(observersCount);
+    }
+
+    size_t GetObserversCount() const {return mObserversList.size();};
+
     private:
     void DoNotifyAll() override
     {
@@ -62,26 +100,40 @@ class ObservableClass : public ObservableInterface<ObservableClass, std::string>
         }
     }
     
-    void DoNotifyOne(const std::shared_ptr<ObserverInterface<ObservableClass>>& observerObj) override
+    void DoNotifyOne(const ObserverPtr& observerObj) override
     {
         observerObj->ProcessChange(*this);
     }
     
-    void DoSubscribe(const std::shared_ptr<ObserverInterface<ObservableClass>>& observerObj) override
+    void DoSubscribe(const ObserverPtr& observerObj) override
+    {
+        AddObserver(observerObj);
+    }
+    
+    void DoUnsubscribe(const ObserverPtr& observerObj) override
     {
-        auto it = std::find(mObserversList.begin(), mObserversList.end(), observerObj);
-        
-        if(it == mObserversList.end())
+        auto it = mHandles.find(observerObj.get());
+
+        if(it != mHandles.end())
         {
-            mObserversList.push_back(std::move(observerObj));
+            mObserversList.erase(it->second);
+            mHandles.erase(it);
         }
     }
-    
-    void DoUnsubscribe(const std::shared_ptr<ObserverInterface<ObservableClass>>& observerObj) override
+
+    SlotHandle AddObserver(const ObserverPtr& observerObj)
     {
-        mObserversList.erase(std::remove(mObserversList.begin(), mObserversList.end(), observerObj), mObserversList.end());
+        auto [it, isInserted] = mHandles.try_emplace(observerObj.get());
+
+        if(isInserted)
+        {
+            it->second = mObserversList.insert(observerObj);
+        }
+
+        return it->second;
     }
     
     std::string mData;
-    std::vector<std::shared_ptr<ObserverInterface<ObservableClass>>> mObserversList;
+    SlotMap<ObserverPtr> mObserversList;
+    std::unordered_map<const ObserverInterface<ObservableClass>*, SlotHandle> mHandles;
 };
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <iostream>
-#include <list>
 #include <algorithm>
 #include <string>
 #include <functional>
+#include <unordered_map>
+
+#include "SlotMap.hpp"
 
 template<class ObservableType>
 class ObserverInterface
@@ -66,8 +68,10 @@ template<class ObservableImpl, class MsgType>
 class ObservableInterface
 {
     public:
-    void AddObserver(ObserverInterface<ObservableImpl>& observerObject);
+    //the returned handle removes the observer in O(1)
+    SlotHandle AddObserver(ObserverInterface<ObservableImpl>& observerObject);
     void RemoveObserver(ObserverInterface<ObservableImpl>& observerObject);
+    void RemoveObserver(const SlotHandle handle);
     void NotifyOne(ObserverInterface<ObservableImpl>& observerObject, MsgType& message);
     void NotifyAll(MsgType& message);
     MsgType GetMessage();
@@ -75,8 +79,9 @@ class ObservableInterface
     virtual ~ObservableInterface() = default;
     
     private:
-    virtual void DoAddObserver(ObserverInterface<ObservableImpl>& observerObject) = 0;
+    virtual SlotHandle DoAddObserver(ObserverInterface<ObservableImpl>& observerObject) = 0;
     virtual void DoRemoveObserver(ObserverInterface<ObservableImpl>& observerObject) = 0;
+    virtual void DoRemoveObserver(const SlotHandle handle) = 0;
     virtual void DoNotifyOne(ObserverInterface<ObservableImpl>& observerObject, MsgType& message) = 0;
     virtual void DoNotifyAll(MsgType& message) = 0;
     virtual size_t DoGetID() = 0;
@@ -84,27 +89,33 @@ class ObservableInterface
 };
 
 template<class ObservableImpl, class MsgType>
-void ObservableInterface<ObservableImpl, MsgType>::AddObserver(ObserverInterface<ObservableImpl>& observerObject)
+SlotHandle ObservableInterface<ObservableImpl, MsgType>::AddObserver(ObserverInterface<ObservableImpl>& observerObject)
 {
-    DoAddObserver(std::forward(observerObject));
+    return DoAddObserver(observerObject);
 }
 
 template<class ObservableImpl, class MsgType>
 void ObservableInterface<ObservableImpl, MsgType>::RemoveObserver(ObserverInterface<ObservableImpl>& observerObject)
 {
-    DoRemoveObserver(std::forward(observerObject));
+    DoRemoveObserver(observerObject);
+}
+
+template<class ObservableImpl, class MsgType>
+void ObservableInterface<ObservableImpl, MsgType>::RemoveObserver(const SlotHandle handle)
+{
+    DoRemoveObserver(handle);
 }
 
 template<class ObservableImpl, class MsgType>
 void ObservableInterface<ObservableImpl, MsgType>::NotifyOne(ObserverInterface<ObservableImpl>& observerObject, MsgType& message)
 {
-    DoNotifyOne(std::forward(observerObject));
+    DoNotifyOne(observerObject, message);
 }
 
 template<class ObservableImpl, class MsgType>
 void ObservableInterface<ObservableImpl, MsgType>::NotifyAll(MsgType& message)
 {
-    DoNotifyAll();
+    DoNotifyAll(message);
 }
 
 template<class ObservableImpl, class MsgType>
@@ -134,37 +145,45 @@ class ObservableImpl : public ObservableInterface<ObservableImpl<MsgType>, MsgTy
     
     
     private:
+    using ObserverRef = std::reference_wrapper<ObserverInterface<ObservableImpl<MsgType>>>;
+
     MsgType mMessage;
-    std::list<std::reference_wrapper<ObserverInterface<ObservableImpl<MsgType>>>> observersList;
+    //the observers are stored contiguously, in a SlotMap, and their handles are indexed by address, so adding and removing are O(1)
+    SlotMap<ObserverRef> observersList;
+    std::unordered_map<const ObserverInterface<ObservableImpl<MsgType>>*, SlotHandle> observersHandles;
     
-    void DoAddObserver(ObserverInterface<ObservableImpl<MsgType>>& observerObject) override
+    SlotHandle DoAddObserver(ObserverInterface<ObservableImpl<MsgType>>& observerObject) override
     {
-        auto it = /*std::find_if( observersList.cbegin(), 
-                                observersList.cend(), 
-                                [&observerObject](std::reference_wrapper<ObserverInterface<ObservableImpl<MsgType>>> rhs)
-                                {
-                                    return observerObject==rhs.get();
-                                }
-                                );*/
-                    std::find( observersList.cbegin(), observersList.cend(), std::cref(observerObject));
+        auto [it, isInserted] = observersHandles.try_emplace(&observerObject);
                                 
-        if(it == observersList.end())
+        if(isInserted)
         {
-            observersList.push_back(observerObject);
+            it->second = observersList.insert(std::ref(observerObject));
         }
+
+        return it->second;
     }
     
     void DoRemoveObserver(ObserverInterface<ObservableImpl<MsgType>>& observerObject) override
     {
-        auto it = /*std::remove_if( observersList.begin(), 
-                                  observersList.end(), 
-                                  [&observerObject](std::reference_wrapper<ObserverInterface<ObservableImpl<MsgType>>> rhs)
-                                    {
-                                        return observerObject==rhs.get();
-                                    });*/
-                std::remove( observersList.begin(), observersList.end(), std::ref(observerObject));
-                                    
-        observersList.erase(it, observersList.end());
+        auto it = observersHandles.find(&observerObject);
+
+        if(it != observersHandles.end())
+        {
+            observersList.erase(it->second);
+            observersHandles.erase(it);
+        }
+    }
+
+    void DoRemoveObserver(const SlotHandle handle) override
+    {
+        const ObserverRef* observerObject = observersList.get(handle);
+
+        if(observerObject)
+        {
+            observersHandles.erase(&observerObject->get());
+            observersList.erase(handle);
+        }
     }
     
     void DoNotifyOne(ObserverInterface<ObservableImpl<MsgType>>& observerObject, MsgType& message) override
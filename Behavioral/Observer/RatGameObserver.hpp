@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 using namespace std;
 
 /*
@@ -11,38 +12,74 @@ using namespace std;
 * but this value should be updated to the total numbe rof rats in game, when more rats join or quit.
 */
 
+/*
+* Notifying every rat of every join or quit makes spawning or despawning n rats O(n^2). Thus, the Game has a second mode,
+* SharedCounter, in which it does not call setAttack at all, but only updates an atomic count of the rats in game, which the
+* rats read when their attack is asked for, by getAttack. In both modes, each rat holds its index in ratsInGame, so quitting
+* moves the last rat in its place (swap and pop), in O(1), instead of searching and erasing it. The order of the rats is not kept.
+*/
+enum class AttackUpdateMode
+{
+    NotifyAll,      //the attack of every rat is set on every join and quit
+    SharedCounter   //the rats read the attack from the game's counter, when needed
+};
+
 struct IRat
 {
     virtual void setAttack(int value) = 0;
+    virtual int getAttack() const = 0;
+
+    //the position in Game::ratsInGame, kept by the game, so the rat is removed without searching it
+    size_t indexInGame{0};
 };
 
 //Game acts as observer class
 struct Game
 {
     vector<IRat*> ratsInGame;
+    AttackUpdateMode mode{AttackUpdateMode::NotifyAll};
+    atomic<int> ratsCount{0};
+
+    Game() = default;
+    explicit Game(AttackUpdateMode mode) : mode(mode) {}
     
     //join and quit Game act as notifiers called from Rat class
     void ratJoined(IRat* sourceObject)
     {
+        sourceObject->indexInGame = ratsInGame.size();
         ratsInGame.push_back(sourceObject);
+        ratsCount.store(static_cast<int>(ratsInGame.size()), memory_order_relaxed);
         
-        for(IRat* rat : ratsInGame)
+        if(mode == AttackUpdateMode::NotifyAll)
         {
-            rat->setAttack(ratsInGame.size());
+            for(IRat* rat : ratsInGame)
+            {
+                rat->setAttack(ratsInGame.size());
+            }
         }
     }
     
     void ratQuit(IRat* sourceObject)
     {
-        //erase remove idiom
-        ratsInGame.erase( remove_if( ratsInGame.begin(), 
-                                     ratsInGame.end(), 
-                                     [sourceObject](IRat* rat){return rat==sourceObject;}),
-                         ratsInGame.end());
+        //a rat which is not in game, at the index it holds, has nothing to remove
+        if(sourceObject->indexInGame >= ratsInGame.size() || ratsInGame[sourceObject->indexInGame] != sourceObject)
+        {
+            return;
+        }
+
+        //swap and pop: the last rat takes the place of the one quitting
+        IRat* lastRat = ratsInGame.back();
+        lastRat->indexInGame = sourceObject->indexInGame;
+        ratsInGame[lastRat->indexInGame] = lastRat;
+        ratsInGame.pop_back();
+        ratsCount.store(static_cast<int>(ratsInGame.size()), memory_order_relaxed);
                          
-        for(IRat* rat : ratsInGame)
+        if(mode == AttackUpdateMode::NotifyAll)
         {
-            rat->setAttack(ratsInGame.size());
+            for(IRat* rat : ratsInGame)
+            {
+                rat->setAttack(ratsInGame.size());
+            }
         }
     }
 };
@@ -59,6 +96,12 @@ struct Rat : public IRat
         game.ratJoined(this);
     }
 
+    //the game keeps the address of the rat, so a copy would not be in game, yet would quit it when destroyed
+    Rat(const Rat&) = delete;
+    Rat(Rat&&) = delete;
+    Rat& operator=(const Rat&) = delete;
+    Rat& operator=(Rat&&) = delete;
+
     ~Rat() 
     { 
         game.ratQuit(this);
@@ -68,5 +111,11 @@ struct Rat : public IRat
     {
         attack = value;
     };
+
+    //in SharedCounter mode, attack is not updated, as the game's counter is read instead
+    int getAttack() const override
+    {
+        return game.mode == AttackUpdateMode::SharedCounter ? game.ratsCount.load(memory_order_relaxed) : attack;
+    }
     
 };
\ No newline at end of file
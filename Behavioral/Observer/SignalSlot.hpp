@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "SlotMap.hpp"
+
+/*
+* Callable wrapper, like std::function, which stores the callable inside itself, in a buffer of Capacity bytes, instead of on the heap.
+* A callable which does not fit is rejected at compile time, rather than silently allocated, so wrapping, moving and calling never
+* allocate. Lambdas capturing a few pointers or references, as slots usually do, fit in the default capacity.
+* It is move only, as the slots of a signal are owned by it, and the callables are not required to be copyable.
+*/
+template<class Signature, size_t Capacity = 4 * sizeof(void*)>
+class InplaceFunction;
+
+template<class ReturnType, class... Args, size_t Capacity>
+class InplaceFunction<ReturnType(Args...), Capacity>
+{
+    public:
+    InplaceFunction() = default;
+
+    template<class Callable, std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, InplaceFunction>, int> = 0>
+    InplaceFunction(Callable&& callable)
+    {
+        using CallableType = std::decay_t<Callable>;
+
+        static_assert(sizeof(CallableType) <= Capacity, "the callable does not fit in the inline buffer, increase its capacity");
+        static_assert(alignof(CallableType) <= alignof(std::max_align_t), "the callable is over aligned");
+        static_assert(std::is_nothrow_move_constructible_v<CallableType>, "the callable must be nothrow move constructible");
+
+        new(mStorage) CallableType(std::forward<Callable>(callable));
+        mOperations = &operationsFor<CallableType>;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        takeCallableOf(other);
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+            takeCallableOf(other);
+        }
+
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction()
+    {
+        reset();
+    }
+
+    //as for std::function, calling a const wrapper may modify the state of the callable
+    ReturnType operator()(Args... args) const
+    {
+        return mOperations->invoke(mStorage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const {return mOperations != nullptr;};
+
+    void reset()
+    {
+        if(mOperations)
+        {
+            mOperations->destroy(mStorage);
+            mOperations = nullptr;
+        }
+    }
+
+    private:
+    //the operations on the stored callable, whose type is only known by the constructor, thus they are stored as function pointers
+    struct Operations
+    {
+        ReturnType (*invoke)(void* storage, Args&&... args);
+        //move constructs the callable in destination, then destroys the source
+        void (*relocate)(void* destination, void* source);
+        void (*destroy)(void* storage);
+    };
+
+    template<class CallableType>
+    static CallableType* getCallable(void* storage)
+    {
+        return std::launder(static_cast<CallableType*>(storage));
+    }
+
+    //a single table per callable type, shared by all the wrappers of that type
+    template<class CallableType>
+    static constexpr Operations operationsFor
+    {
+        [](void* storage, Args&&... args) -> ReturnType
+        {
+            return (*getCallable<CallableType>(storage))(std::forward<Args>(args)...);
+        },
+        [](void* destination, void* source)
+        {
+            new(destination) CallableType(std::move(*getCallable<CallableType>(source)));
+            getCallable<CallableType>(source)->~CallableType();
+        },
+        [](void* storage)
+        {
+            getCallable<CallableType>(storage)->~CallableType();
+        }
+    };
+
+    alignas(std::max_align_t) mutable unsigned char mStorage[Capacity];
+    const Operations* mOperations{nullptr};
+
+    void takeCallableOf(InplaceFunction& other)
+    {
+        if(other.mOperations)
+        {
+            other.mOperations->relocate(mStorage, other.mStorage);
+            mOperations = other.mOperations;
+            other.mOperations = nullptr;
+        }
+    }
+};
+
+/*
+* Signal, to which slots are connected, which are called, in no particular order, by Emit, with a const reference to the data.
+* The slots are inline callables, stored contiguously in a SlotMap, so connecting returns a handle which disconnects in O(1),
+* and emitting neither allocates, nor copies the data, nor makes virtual calls: each slot is an indirect call to its callable.
+* The slots must not connect or disconnect slots of the same signal during Emit, as that would move the slots being iterated.
+*/
+template<class DataType, size_t SlotCapacity = 4 * sizeof(void*)>
+class Signal
+{
+    public:
+    using Slot = InplaceFunction<void(const DataType&), SlotCapacity>;
+
+    template<class Callable>
+    SlotHandle Connect(Callable&& callable)
+    {
+        return mSlots.emplace(std::forward<Callable>(callable));
+    }
+
+    //connects a member function of observer, e.g. signal.Connect<&Observer::OnChange>(observer)
+    template<auto Method, class Observer>
+    SlotHandle Connect(Observer& observer)
+    {
+        return Connect([&observer](const DataType& data){(observer.*Method)(data);});
+    }
+
+    //returns false if the handle is stale, as its slot has already been disconnected
+    bool Disconnect(const SlotHandle handle)
+    {
+        return mSlots.erase(handle);
+    }
+
+    void Emit(const DataType& data) const
+    {
+        for(const Slot& slot : mSlots)
+        {
+            slot(data);
+        }
+    }
+
+    size_t GetSlotsCount() const {return mSlots.size();};
+
+    private:
+    SlotMap<Slot> mSlots;
+};
+
+/*
+* Compile time counterpart of ObservableInterface: the observable Impl inherits from SignalSource<Impl, DataType> (CRTP), which
+* gets the data to send via Impl::GetData, statically bound, so the observable has no virtual methods. The observers are not
+* objects implementing ObserverInterface, held by shared_ptr, but any callables taking a const DataType&, subscribed by value.
+* GetData should return a const reference, so that NotifyAll passes the observable's data to all the slots, without copying it.
+*/
+template<class Impl, class DataType, size_t SlotCapacity = 4 * sizeof(void*)>
+class SignalSource
+{
+    public:
+    template<class Callable>
+    SlotHandle Subscribe(Callable&& callable)
+    {
+        return mSignal.Connect(std::forward<Callable>(callable));
+    }
+
+    template<auto Method, class Observer>
+    SlotHandle Subscribe(Observer& observer)
+    {
+        return mSignal.template Connect<Method>(observer);
+    }
+
+    bool Unsubscribe(const SlotHandle handle)
+    {
+        return mSignal.Disconnect(handle);
+    }
+
+    void NotifyAll() const
+    {
+        mSignal.Emit(static_cast<const Impl&>(*this).GetData());
+    }
+
+    size_t GetObserversCount() const {return mSignal.GetSlotsCount();};
+
+    protected:
+    //not meant to be used polymorphically, so the destructor is not virtual, but protected
+    ~SignalSource() = default;
+
+    private:
+    Signal<DataType, SlotCapacity> mSignal;
+};
+
+//the counterpart of ObservableClass, whose observers receive a reference to its data, instead of a copy
+class SignalingClass : public SignalSource<SignalingClass, std::string>
+{
+    public:
+    void SetData(const std::string& str){mData = str;};
+    const std::string& GetData() const {return mData;};
+
+    private:
+    std::string mData;
+};
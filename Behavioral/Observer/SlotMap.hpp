@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+//identifies an element of a SlotMap, stays valid till the element is erased, whatever other elements are inserted or erased
+struct SlotHandle
+{
+    static constexpr std::uint32_t nullIndex{UINT32_MAX};
+
+    std::uint32_t index{nullIndex};
+    std::uint32_t generation{0};
+
+    friend bool operator==(const SlotHandle& lhs, const SlotHandle& rhs)
+    {
+        return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+
+    friend bool operator!=(const SlotHandle& lhs, const SlotHandle& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/*
+* Container giving O(1) insertion, erasure and lookup by handle, whilst its elements are stored contiguously, so iterating them
+* is as fast as iterating a vector. The elements are kept packed in a dense vector: erasing one moves the last element in its place.
+* As the elements move, the handles do not point to them directly, but to slots, which store the current position of their element,
+* and which are never moved. An erased element's slot is reused by a later insertion, so each slot has a generation, incremented
+* when its element is erased: a handle to an erased element has an older generation than its slot, hence it is detected as stale,
+* rather than finding the element inserted later in the same slot.
+*
+* The order of the elements is not preserved by erasure. Each handle takes 8 bytes, as 32 bits indices are enough for
+* up to 4 billion elements, and the generation wraps around after 4 billion reuses of the same slot.
+*/
+template<class T>
+class SlotMap
+{
+    public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    template<class... Args>
+    SlotHandle emplace(Args&&... args)
+    {
+        std::uint32_t slotIdx;
+
+        if(mFreeSlotsHead != SlotHandle::nullIndex)
+        {
+            //a free slot stores the index of the next free one, instead of the position of an element
+            slotIdx = mFreeSlotsHead;
+            mFreeSlotsHead = mSlots[slotIdx].position;
+        }
+        else
+        {
+            slotIdx = static_cast<std::uint32_t>(mSlots.size());
+            mSlots.push_back(Slot{});
+        }
+
+        mValues.emplace_back(std::forward<Args>(args)...);
+        mSlotsOfValues.push_back(slotIdx);
+        mSlots[slotIdx].position = static_cast<std::uint32_t>(mValues.size() - 1);
+
+        return SlotHandle{slotIdx, mSlots[slotIdx].generation};
+    }
+
+    SlotHandle insert(const T& value) {return emplace(value);};
+    SlotHandle insert(T&& value) {return emplace(std::move(value));};
+
+    //returns false if the handle is stale, as its element has already been erased
+    bool erase(const SlotHandle handle)
+    {
+        if(!contains(handle))
+        {
+            return false;
+        }
+
+        const std::uint32_t position = mSlots[handle.index].position;
+        const std::uint32_t lastPosition = static_cast<std::uint32_t>(mValues.size() - 1);
+
+        //swap and pop: the last element fills the hole, then its slot is updated to its new position
+        if(position != lastPosition)
+        {
+            mValues[position] = std::move(mValues[lastPosition]);
+            mSlotsOfValues[position] = mSlotsOfValues[lastPosition];
+            mSlots[mSlotsOfValues[position]].position = position;
+        }
+
+        mValues.pop_back();
+        mSlotsOfValues.pop_back();
+
+        ++mSlots[handle.index].generation;
+        mSlots[handle.index].position = mFreeSlotsHead;
+        mFreeSlotsHead = handle.index;
+
+        return true;
+    }
+
+    bool contains(const SlotHandle handle) const
+    {
+        return handle.index < mSlots.size() && mSlots[handle.index].generation == handle.generation;
+    }
+
+    //returns nullptr if the handle is stale
+    T* get(const SlotHandle handle)
+    {
+        return contains(handle) ? &mValues[mSlots[handle.index].position] : nullptr;
+    }
+
+    const T* get(const SlotHandle handle) const
+    {
+        return contains(handle) ? &mValues[mSlots[handle.index].position] : nullptr;
+    }
+
+    void reserve(const std::size_t capacity)
+    {
+        mValues.reserve(capacity);
+        mSlotsOfValues.reserve(capacity);
+        mSlots.reserve(capacity);
+    }
+
+    void clear()
+    {
+        //the slots are kept, with newer generations, so that the handles given so far become stale
+        for(const std::uint32_t slotIdx : mSlotsOfValues)
+        {
+            ++mSlots[slotIdx].generation;
+            mSlots[slotIdx].position = mFreeSlotsHead;
+            mFreeSlotsHead = slotIdx;
+        }
+
+        mValues.clear();
+        mSlotsOfValues.clear();
+    }
+
+    std::size_t size() const {return mValues.size();};
+    bool empty() const {return mValues.empty();};
+
+    //the elements are iterated in their storage order, which is not the insertion order
+    iterator begin() {return mValues.begin();};
+    iterator end() {return mValues.end();};
+    const_iterator begin() const {return mValues.begin();};
+    const_iterator end() const {return mValues.end();};
+
+    private:
+    struct Slot
+    {
+        //the position of the element in mValues, or, for a free slot, the index of the next free slot
+        std::uint32_t position{SlotHandle::nullIndex};
+        std::uint32_t generation{0};
+    };
+
+    std::vector<T> mValues;
+    //the slot of each element, to update it when the element is moved by an erasure
+    std::vector<std::uint32_t> mSlotsOfValues;
+    std::vector<Slot> mSlots;
+    std::uint32_t mFreeSlotsHead{SlotHandle::nullIndex};
+};
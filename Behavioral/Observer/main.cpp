@@ -1,6 +1,14 @@
 #include "RatGameObserver.hpp"
 
 #include "Observer.hpp"
+#include "Observable.hpp"
+#include "ConcurrentObservable.hpp"
+#include "AsyncObservable.hpp"
+#include "SignalSlot.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 /*
 * Observer is a behavioral design pattern which involves 2 entities:
@@ -67,6 +75,44 @@
 * interface) which would allow different components to implement specific behavior for an observable's notification.
 */
 
+//counts the notifications, which may be received by several threads at once
+class CountingObserver : public ObserverInterface<ConcurrentObservableClass>
+{
+    public:
+    void ProcessChange(const ConcurrentObservableClass&) override
+    {
+        notificationsCount.fetch_add(1, memory_order_relaxed);
+    }
+
+    atomic<size_t> notificationsCount{0};
+};
+
+//takes a while to process each notification, which would stall the notifying thread if the delivery was synchronous
+class SlowObserver : public ObserverInterface<AsyncObservableClass>
+{
+    public:
+    void ProcessChange(const AsyncObservableClass& observedObj) override
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+        lastData = observedObj.GetData();
+        ++notificationsCount;
+    }
+
+    string lastData;
+    size_t notificationsCount{0};
+};
+
+//observes a SignalingClass without implementing any interface, its method being connected as a slot
+struct LengthObserver
+{
+    void OnChange(const string& data)
+    {
+        totalLength += data.size();
+    }
+
+    size_t totalLength{0};
+};
+
 int main()
 {
     ObservableClass observed;
@@ -79,6 +125,91 @@ int main()
 	observed.Subscribe(make_shared<ObserverImplementation<ObservableClass>>());
 	observed.SetData("update data change");
 	observed.NotifyAll();
+
+    //the handle returned by Subscribe unsubscribes in O(1), then becomes stale
+    SlotHandle handle = observed.Subscribe(make_shared<ObserverImplementation<ObservableClass>>());
+    cout<<"observers: "<<observed.GetObserversCount();
+    bool isUnsubscribed = observed.Unsubscribe(handle);
+    bool isUnsubscribedAgain = observed.Unsubscribe(handle);
+    cout<<", after unsubscribing: "<<observed.GetObserversCount()<<boolalpha<<" ("<<isUnsubscribed<<", then "<<isUnsubscribedAgain<<")"<<endl;
+
+    //producers notify concurrently, while another thread subscribes and unsubscribes, without blocking them
+    ConcurrentObservableClass concurrentObserved;
+    auto firstCounter = make_shared<CountingObserver>();
+    auto secondCounter = make_shared<CountingObserver>();
+    concurrentObserved.Subscribe(firstCounter);
+    concurrentObserved.Subscribe(secondCounter);
+
+    vector<thread> producers;
+    for(int producerIdx{0}; producerIdx < 4; ++producerIdx)
+    {
+        producers.emplace_back([&concurrentObserved, producerIdx]()
+        {
+            for(int notificationIdx{0}; notificationIdx < 1000; ++notificationIdx)
+            {
+                concurrentObserved.SetData("producer " + to_string(producerIdx));
+                concurrentObserved.NotifyAll();
+            }
+        });
+    }
+
+    thread subscriber([&concurrentObserved]()
+    {
+        auto transientCounter = make_shared<CountingObserver>();
+        for(int subscriptionIdx{0}; subscriptionIdx < 1000; ++subscriptionIdx)
+        {
+            concurrentObserved.Subscribe(transientCounter);
+            concurrentObserved.Unsubscribe(transientCounter);
+        }
+    });
+
+    for(thread& producer : producers)
+    {
+        producer.join();
+    }
+    subscriber.join();
+
+    cout<<"concurrent notifications received: "<<firstCounter->notificationsCount<<" and "<<secondCounter->notificationsCount
+        <<", observers left: "<<concurrentObserved.GetObserversCount()<<endl;
+
+    //the changes set while the slow observer processes a notification are merged, so it only gets the latest
+    auto slowObserver = make_shared<SlowObserver>();
+    {
+        AsyncObservableClass asyncObserved{AsyncDeliveryOptions{}};
+        asyncObserved.Subscribe(slowObserver);
+
+        for(int changeIdx{0}; changeIdx < 1000; ++changeIdx)
+        {
+            asyncObserved.SetData("change " + to_string(changeIdx));
+            asyncObserved.NotifyAll();
+        }
+        asyncObserved.Flush();
+    }
+    cout<<"slow observer got "<<slowObserver->lastData<<" after less than 1000 notifications: "<<boolalpha
+        <<(slowObserver->notificationsCount < 1000)<<endl;
+
+    //the slots are called with a reference to the data of the signaling object, without copies nor allocations
+    SignalingClass signaling;
+    LengthObserver lengthObserver;
+    signaling.Subscribe<&LengthObserver::OnChange>(lengthObserver);
+    SlotHandle printingSlot = signaling.Subscribe([](const string& data){cout<<"slot received "<<data<<endl;});
+    signaling.SetData("signal");
+    signaling.NotifyAll();
+    signaling.Unsubscribe(printingSlot);
+    signaling.SetData("another signal");
+    signaling.NotifyAll();
+    cout<<"length observer counted "<<lengthObserver.totalLength<<" characters"<<endl;
+
+    //in the shared counter mode, spawning and despawning rats does not notify all the others, which read the count when needed
+    Game ratsGame{AttackUpdateMode::SharedCounter};
+    vector<unique_ptr<Rat>> rats;
+    for(int ratIdx{0}; ratIdx < 50000; ++ratIdx)
+    {
+        rats.push_back(make_unique<Rat>(ratsGame));
+    }
+    cout<<"rat attack after spawning: "<<rats.front()->getAttack();
+    rats.resize(20000);
+    cout<<", after despawning: "<<rats.front()->getAttack()<<endl;
     
     return 0;
 }